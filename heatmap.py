@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Usage Heatmap
+Pulls the live usage counters (keymap/usage_counters.h) over raw HID and overlays them onto the
+keymap-drawer layer diagrams in draw/ - one heat tint per key, hover for the count
+"""
+
+import argparse
+import json
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent
+DRAW = ROOT / 'draw'
+COMBOS = ROOT / 'keymap' / 'combo_system.h'
+LEADER = ROOT / 'keymap' / 'leader_trie.h'
+
+# enum planck_layers order → draw/generate.sh output names
+LAYERS = ['def', 'num', 'gaming', 'fn', 'sys', 'nav', 'mouse', 'midi']
+KEYS = 48
+FINGERS = ['A', 'R', 'S', 'T', 'N', 'E', 'I', 'O']
+
+# Raw HID protocol (see RAW HID PROTOCOL in usage_counters.h)
+USAGE_PAGE, USAGE = 0xFF60, 0x61
+REPORT = 32
+CMD_INFO, CMD_READ, CMD_RESET, CMD_ERROR = 0x01, 0x02, 0x03, 0xFF
+VERSION = 1
+TABLES = ['presses', 'hrm_taps', 'hrm_holds', 'combos', 'leader']
+
+
+class Keyboard:
+    def __init__(self):
+        try:
+            import hid
+        except ImportError:
+            sys.exit('❌ Needs hidapi: pip install hid')
+        for info in hid.enumerate():
+            if info['usage_page'] == USAGE_PAGE and info['usage'] == USAGE:
+                self.device = hid.Device(path=info['path'])
+                return
+        sys.exit('❌ No raw HID interface found - is the keyboard flashed with RAW_ENABLE?')
+
+    def request(self, *payload: int) -> bytes:
+        report = bytes(payload).ljust(REPORT, b'\0')
+        self.device.write(b'\0' + report)  # Report id 0
+        reply = self.device.read(REPORT, 1000)
+        if not reply or reply[0] == CMD_ERROR or reply[0] != payload[0]:
+            sys.exit(f'❌ Bad reply to command 0x{payload[0]:02X}')
+        return reply
+
+    def read(self) -> dict:
+        info = self.request(CMD_INFO)
+        if info[1] != VERSION:
+            sys.exit(f'❌ Firmware speaks protocol {info[1]}, this tool speaks {VERSION}')
+
+        counters = {}
+        for table, name in enumerate(TABLES[:info[2]]):
+            length = info[3 + table * 2] | info[4 + table * 2] << 8
+            values = []
+            while len(values) < length:
+                offset = len(values)
+                reply = self.request(CMD_READ, table, offset & 0xFF, offset >> 8)
+                values += [reply[5 + i * 2] | reply[6 + i * 2] << 8 for i in range(reply[4])]
+            counters[name] = values
+        return counters
+
+    def reset(self) -> None:
+        self.request(CMD_RESET)
+
+
+def combo_names() -> list:
+    """Combo index → name, from enum combo_events."""
+    source = re.sub(r'//.*', '', COMBOS.read_text(encoding='utf-8'))  # Comments name brace keys
+    body = re.search(r'enum combo_events\s*\{(.*?)\}', source, re.S).group(1)
+    return [name for name in re.findall(r'\b([A-Z][A-Z0-9_]*)\b', body) if name != 'COMBO_LENGTH']
+
+
+def leader_paths() -> dict:
+    """Trie node → 'a e: ä' label, from the comments leader_gen.py writes."""
+    return {int(index): label.strip()
+            for index, label in re.findall(r'/\*\s*(\d+) \*/.*?//(.*)', LEADER.read_text(encoding='utf-8'))}
+
+
+def heat(count: int, peak: int) -> str:
+    """White → yellow → red, square-root scaled so rare keys still show."""
+    t = (count / peak) ** 0.5 if peak else 0
+    if t < 0.5:
+        return f'rgb(255,{255 - int(t * 2 * 55)},{255 - int(t * 2 * 255)})'
+    return f'rgb(255,{200 - int((t - 0.5) * 2 * 200)},0)'
+
+
+def overlay(svg: str, counts: list) -> str:
+    peak = max(counts) or 1
+
+    def tint(match: re.Match) -> str:
+        count = counts[int(match.group(2))]
+        if not count:
+            return match.group(0)
+        return (match.group(0) +
+                f'\n<rect rx="6" ry="6" x="-28" y="-26" width="56" height="52" '
+                f'style="fill:{heat(count, peak)};fill-opacity:0.6;stroke:none"><title>{count}</title></rect>')
+
+    return re.sub(r'(class="key keypos-(\d+)">\n<rect[^>]*/>)', tint, svg)
+
+
+def report(counters: dict, out: Path) -> None:
+    presses = counters['presses']
+    for layer, name in enumerate(LAYERS):
+        counts = presses[layer * KEYS:(layer + 1) * KEYS]
+        source = DRAW / f'{name}-layer.svg'
+        if not sum(counts) or not source.exists():
+            continue
+        (out / source.name).write_text(overlay(source.read_text(encoding='utf-8'), counts), encoding='utf-8')
+        print(f'🔥 {name:<7} {sum(counts):6} presses → {out / source.name}')
+
+    print('\nHomerow mods     ' + ' '.join(f'{f:>6}' for f in FINGERS))
+    print('  tap            ' + ' '.join(f'{n:6}' for n in counters['hrm_taps']))
+    print('  hold           ' + ' '.join(f'{n:6}' for n in counters['hrm_holds']))
+
+    names = combo_names()
+    hits = sorted(((n, names[i] if i < len(names) else f'combo {i}') for i, n in enumerate(counters['combos']) if n),
+                  reverse=True)
+    if hits:
+        print('\nCombos')
+        for count, name in hits:
+            print(f'  {name:<24} {count:6}')
+
+    paths = leader_paths()
+    used = sorted(((n, paths.get(i, f'node {i}')) for i, n in enumerate(counters['leader']) if n), reverse=True)
+    if used:
+        print('\nLeader sequences')
+        for count, path in used:
+            print(f'  {path:<24} {count:6}')
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--load', type=Path, help='render a saved snapshot instead of reading the keyboard')
+    parser.add_argument('--save', type=Path, help='also write the counters to a JSON snapshot')
+    parser.add_argument('--reset', action='store_true', help='clear the counters on the keyboard after reading')
+    parser.add_argument('--out', type=Path, default=DRAW / 'heatmap', help='output directory (default draw/heatmap)')
+    args = parser.parse_args()
+
+    if args.load:
+        counters = json.loads(args.load.read_text(encoding='utf-8'))
+    else:
+        keyboard = Keyboard()
+        counters = keyboard.read()
+        if args.reset:
+            keyboard.reset()
+    if args.save:
+        args.save.write_text(json.dumps(counters), encoding='utf-8')
+
+    args.out.mkdir(parents=True, exist_ok=True)
+    report(counters, args.out)
+
+
+if __name__ == '__main__':
+    main()
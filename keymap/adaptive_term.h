@@ -0,0 +1,144 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * ADAPTIVE TAPPING TERM
+ * Per-key homerow mod terms learned from misfires, persisted in EEPROM
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "bilateral_mods.h"
+#include "custom_keycodes.h"  // For U_NAV_BS
+#include "event_log.h"
+#include "scan_profiler.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  ADAPTIVE TERM STORAGE                                                                             ║
+ * ║  One signed 4-bit offset per homerow position, packed into the 32-bit user EEPROM word             ║
+ * ║  Position = finger: NUM_0/4/5/6 share the A/R/S/T slots they physically sit on                     ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Tuning knobs (override in config.h)
+#ifndef ADAPTIVE_TERM_STEP
+#    define ADAPTIVE_TERM_STEP 10          // ms per learned adjustment (one nibble step)
+#endif
+#ifndef ADAPTIVE_TERM_MIN
+#    define ADAPTIVE_TERM_MIN 200          // Never faster than this
+#endif
+#ifndef ADAPTIVE_TERM_MAX
+#    define ADAPTIVE_TERM_MAX 350          // Never slower than this
+#endif
+#ifndef ADAPTIVE_TERM_WINDOW
+#    define ADAPTIVE_TERM_WINDOW 600       // Follow-up within this time counts as a correction
+#endif
+#ifndef ADAPTIVE_TERM_FLUSH_DELAY
+#    define ADAPTIVE_TERM_FLUSH_DELAY 30000 // Batch EEPROM writes: flush 30s after the first change
+#endif
+
+#define ADAPTIVE_TERM_KEYS 8
+#define ADAPTIVE_TERM_NONE 0xFF
+
+static int8_t         adaptive_offsets[ADAPTIVE_TERM_KEYS];  // Steps relative to TAPPING_TERM (-8..+7)
+static uint16_t       adaptive_last_tap[ADAPTIVE_TERM_KEYS]; // Last tap time per key (retry detection)
+static uint8_t        adaptive_hold_idx   = ADAPTIVE_TERM_NONE;  // Last released hold, armed for Backspace
+static uint16_t       adaptive_hold_time  = 0;
+static deferred_token adaptive_flush_token = INVALID_DEFERRED_TOKEN;
+
+// Homerow position of a mod-tap key, or ADAPTIVE_TERM_NONE
+static uint8_t adaptive_term_index(uint16_t keycode) {
+    switch (keycode) {
+        case HRM_A: case NUM_0: return 0;
+        case HRM_R: case NUM_4: return 1;
+        case HRM_S: case NUM_5: return 2;
+        case HRM_T: case NUM_6: return 3;
+        case HRM_N:             return 4;
+        case HRM_E:             return 5;
+        case HRM_I:             return 6;
+        case HRM_O:             return 7;
+        default:                return ADAPTIVE_TERM_NONE;
+    }
+}
+
+void adaptive_term_load(void) {
+    uint32_t packed = eeconfig_read_user();
+    for (uint8_t i = 0; i < ADAPTIVE_TERM_KEYS; i++) {
+        int8_t nibble = (packed >> (i * 4)) & 0x0F;
+        adaptive_offsets[i] = nibble > 7 ? nibble - 16 : nibble;  // Sign-extend
+    }
+}
+
+static uint32_t adaptive_term_flush(uint32_t trigger_time, void *cb_arg) {
+    PROFILE_SCOPE(PROF_EEPROM);
+    uint32_t packed = 0;
+    for (uint8_t i = 0; i < ADAPTIVE_TERM_KEYS; i++) {
+        packed |= (uint32_t)(adaptive_offsets[i] & 0x0F) << (i * 4);
+    }
+    eeconfig_update_user(packed);  // Single write for every change since the last flush
+    adaptive_flush_token = INVALID_DEFERRED_TOKEN;
+    return 0;
+}
+
+// Tapping term for a homerow mod, clamped to the configured bounds
+uint16_t adaptive_tapping_term(uint16_t keycode) {
+    uint8_t idx = adaptive_term_index(keycode);
+    if (idx == ADAPTIVE_TERM_NONE) return TAPPING_TERM;
+
+    int16_t term = TAPPING_TERM + adaptive_offsets[idx] * ADAPTIVE_TERM_STEP;
+    if (term < ADAPTIVE_TERM_MIN) term = ADAPTIVE_TERM_MIN;
+    if (term > ADAPTIVE_TERM_MAX) term = ADAPTIVE_TERM_MAX;
+    return (uint16_t)term;
+}
+
+static void adaptive_term_adjust(uint8_t idx, int8_t steps) {
+    int8_t offset = adaptive_offsets[idx] + steps;
+    if (offset < -8 || offset > 7) return;  // Nibble exhausted
+
+    int16_t term = TAPPING_TERM + offset * ADAPTIVE_TERM_STEP;
+    if (term < ADAPTIVE_TERM_MIN || term > ADAPTIVE_TERM_MAX) return;
+
+    adaptive_offsets[idx] = offset;
+    if (adaptive_flush_token == INVALID_DEFERRED_TOKEN) {
+        adaptive_flush_token = defer_exec(ADAPTIVE_TERM_FLUSH_DELAY, adaptive_term_flush, NULL);
+    }
+    LOG_INFO(EV_ADAPTIVE_TERM, idx, term);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  MISFIRE DETECTION                                                                                 ║
+ * ║  Hold then Backspace        → hold fired too early → raise that key's term                         ║
+ * ║  Tap then same key as hold  → tap fired instead of the mod, user retried → lower that key's term    ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+void process_adaptive_term(uint16_t keycode, keyrecord_t *record) {
+    uint8_t idx = adaptive_term_index(keycode);
+
+    if (idx != ADAPTIVE_TERM_NONE) {
+        bool is_hold = record->tap.count == 0;
+
+        if (record->event.pressed) {
+            if (!is_hold) {
+                adaptive_last_tap[idx] = record->event.time;
+            } else if (adaptive_last_tap[idx] &&
+                       TIMER_DIFF_16(record->event.time, adaptive_last_tap[idx]) < ADAPTIVE_TERM_WINDOW) {
+                // Same key typed, then immediately retried as a mod: the tap was a misfire
+                adaptive_term_adjust(idx, -1);
+                adaptive_last_tap[idx] = 0;
+            }
+        } else if (is_hold) {
+            // Arm Backspace detection from the moment the mod is let go
+            adaptive_hold_idx  = idx;
+            adaptive_hold_time = record->event.time;
+        }
+        return;
+    }
+
+    if (!record->event.pressed || adaptive_hold_idx == ADAPTIVE_TERM_NONE) return;
+
+    // First key after a hold: Backspace right away means the hold was unwanted
+    if ((keycode == KC_BSPC || keycode == U_NAV_BS) &&
+        TIMER_DIFF_16(record->event.time, adaptive_hold_time) < ADAPTIVE_TERM_WINDOW) {
+        adaptive_term_adjust(adaptive_hold_idx, +1);
+    }
+    adaptive_hold_idx = ADAPTIVE_TERM_NONE;
+}
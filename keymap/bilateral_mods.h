@@ -38,7 +38,10 @@
  * ║  BILATERAL HOMEROW MODS CONFIGURATION FUNCTIONS                                                     ║
  * ╚═════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-// Per-key tapping term - urob's approach uses consistent 280ms
+// Learned per-key term (adaptive_term.h) - starts at urob's 280ms
+uint16_t adaptive_tapping_term(uint16_t keycode);
+
+// Per-key tapping term - urob's 280ms baseline, tuned per finger from misfires
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
     switch (keycode) {
         // Homerow mods - base layer
@@ -55,13 +58,76 @@ uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
         case NUM_4:
         case NUM_5:
         case NUM_6:
-            return TAPPING_TERM;  // Same 280ms as urob
+            return adaptive_tapping_term(keycode);
         default:
             return TAPPING_TERM;
     }
 }
 
+/* ╔═════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  POSITIONAL HOLD-TAP RESOLUTION (HAND TABLE)                                                        ║
+ * ║  Same hand → tap immediately, opposite hand → hold immediately (HOLD_ON_OTHER_KEY_PRESS)            ║
+ * ╚═════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Hand for every matrix position: 'L' = left, 'R' = right, '*' = exempt (thumb row, counts as either hand)
+const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM = LAYOUT_planck_grid(
+    'L', 'L', 'L', 'L', 'L', 'L',   'R', 'R', 'R', 'R', 'R', 'R',
+    'L', 'L', 'L', 'L', 'L', 'L',   'R', 'R', 'R', 'R', 'R', 'R',
+    'L', 'L', 'L', 'L', 'L', 'L',   'R', 'R', 'R', 'R', 'R', 'R',
+    '*', '*', '*', '*', '*', '*',   '*', '*', '*', '*', '*', '*'
+);
+
+// Positional resolution only for the homerow mods - layer-taps like GAME_ESC keep plain hold behavior
+bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record,
+                      uint16_t other_keycode, keyrecord_t *other_record) {
+    switch (tap_hold_keycode) {
+        // Base layer homerow mods
+        case HRM_A:
+        case HRM_R:
+        case HRM_S:
+        case HRM_T:
+        case HRM_N:
+        case HRM_E:
+        case HRM_I:
+        case HRM_O:
+        // Number layer homerow mods
+        case NUM_0:
+        case NUM_4:
+        case NUM_5:
+        case NUM_6:
+            // Same hand → settle as tap now, opposite hand / thumb → allow hold
+            return get_chordal_hold_default(tap_hold_record, other_record);
+        default:
+            return true;
+    }
+}
+
+// urob's require-prior-idle-ms - mid-word homerow mods resolve as taps at press time
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    switch (keycode) {
+        // Base layer homerow mods
+        case HRM_A:
+        case HRM_R:
+        case HRM_S:
+        case HRM_T:
+        case HRM_N:
+        case HRM_E:
+        case HRM_I:
+        case HRM_O:
+        // Number layer homerow mods
+        case NUM_0:
+        case NUM_4:
+        case NUM_5:
+        case NUM_6:
+            // Only a preceding typing key (alpha, space, punctuation) starts a streak
+            return is_flow_tap_key(prev_keycode) ? FLOW_TAP_TERM : 0;
+        default:
+            return 0;
+    }
+}
+
 // Bilateral combinations - only apply permissive hold to opposite hand combinations
+// (same-hand chords never reach this point: chordal hold already settled them as taps)
 bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) {
     switch (keycode) {
         // Apply permissive hold to all homerow mods for bilateral combinations
@@ -84,3 +150,27 @@ bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) {
             return false;
     }
 }
+
+// Bilateral combinations - an opposite-hand or thumb press makes the homerow mod a hold right away
+// (same-hand presses never reach this point: chordal hold already settled them as taps)
+bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) {
+    switch (keycode) {
+        // Base layer homerow mods
+        case HRM_A:
+        case HRM_R:
+        case HRM_S:
+        case HRM_T:
+        case HRM_N:
+        case HRM_E:
+        case HRM_I:
+        case HRM_O:
+        // Number layer homerow mods
+        case NUM_0:
+        case NUM_4:
+        case NUM_5:
+        case NUM_6:
+            return true;
+        default:
+            return false;
+    }
+}
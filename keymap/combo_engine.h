@@ -0,0 +1,356 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * INDEXED COMBO ENGINE
+ * Replaces QMK's scan-every-combo loop: each key only ever looks at the combos that contain it
+ * Combos are physical positions, so one definition works on every layer
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "scan_profiler.h"
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  COMBO DESCRIPTORS                                                                                 ║
+ * ║  One const entry per combo - the table lives in combo_system.h, sized by COMBO_LENGTH              ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifndef COMBO_MAX_KEYS
+#    define COMBO_MAX_KEYS 4            // Longest combo
+#endif
+#ifndef COMBO_ACTIVE_SLOTS
+#    define COMBO_ACTIVE_SLOTS 4        // Combos held down at the same time
+#endif
+
+#define COMBO_END            0xFF       // Terminates a position list
+#define COMBO_POSITIONS      (MATRIX_ROWS * MATRIX_COLS)
+#define COMBO_LAYERS         16
+#define COMBO_LAYER(layer)   (1 << (layer))
+#define COMBO_ALL_LAYERS     0xFFFF
+#define COMBO_NONE           0xFFFF
+
+typedef struct {
+    const uint8_t  *keys;           // COMBO_END-terminated key positions (PROGMEM)
+    uint16_t        output;         // Keycode held while the combo is, KC_NO = combo_action_event()
+    const uint16_t *layer_outputs;  // Optional [COMBO_LAYERS] overrides, KC_NO entries keep `output`
+    uint16_t        layers;         // Highest active layers the combo is live on (COMBO_LAYER bits)
+    uint8_t         term;           // Max ms from first to last key
+} combo_def_t;
+
+extern const combo_def_t combo_defs[COMBO_LENGTH];
+
+// Keymap hooks (combo_system.h)
+extern const uint8_t combo_position_map[MATRIX_ROWS][MATRIX_COLS];  // Matrix → combo key position
+bool combos_allowed(void);                              // Global gate, checked once per press
+void combo_action_event(uint16_t index, bool pressed);  // Combos whose output is KC_NO
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  COMBO BITMASKS                                                                                    ║
+ * ║  One bit per combo - candidate narrowing is a handful of word ANDs, whatever the table size        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define COMBO_MASK_WORDS ((COMBO_LENGTH + 31) / 32)
+
+typedef struct {
+    uint32_t w[COMBO_MASK_WORDS];
+} combo_mask_t;
+
+static inline void combo_mask_set(combo_mask_t *mask, uint16_t index) {
+    mask->w[index / 32] |= (uint32_t)1 << (index % 32);
+}
+
+static inline void combo_mask_clear(combo_mask_t *mask, uint16_t index) {
+    mask->w[index / 32] &= ~((uint32_t)1 << (index % 32));
+}
+
+// dst &= src - returns true while any bit is left
+static inline bool combo_mask_and(combo_mask_t *dst, const combo_mask_t *src) {
+    uint32_t any = 0;
+    for (uint8_t i = 0; i < COMBO_MASK_WORDS; i++) {
+        dst->w[i] &= src->w[i];
+        any |= dst->w[i];
+    }
+    return any;
+}
+
+// Next set bit at or after `from`, COMBO_NONE when exhausted - iterates candidates, not the table
+static inline uint16_t combo_mask_next(const combo_mask_t *mask, uint16_t from) {
+    for (uint16_t word = from / 32; word < COMBO_MASK_WORDS; word++) {
+        uint32_t bits = mask->w[word];
+        if (word == from / 32) bits &= ~(uint32_t)0 << (from % 32);
+        if (bits) return word * 32 + __builtin_ctz(bits);
+    }
+    return COMBO_NONE;
+}
+
+#define COMBO_MASK_FOREACH(index, mask) \
+    for (uint16_t index = combo_mask_next((mask), 0); index != COMBO_NONE; index = combo_mask_next((mask), index + 1))
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  CANDIDATE INDEX                                                                                   ║
+ * ║  Key position → combos containing it, layer → combos live on it - one load each per press          ║
+ * ║  Built once at boot from combo_defs[] - C can't derive one const table from another                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static combo_mask_t combo_position_index[COMBO_POSITIONS];
+static combo_mask_t combo_layer_index[COMBO_LAYERS];
+static uint8_t      combo_key_counts[COMBO_LENGTH];
+static uint8_t      combo_terms[COMBO_LENGTH];  // Live terms - seeded from combo_defs[], retuned by telemetry
+
+void combo_engine_init(void) {
+    for (uint16_t i = 0; i < COMBO_LENGTH; i++) {
+        const combo_def_t *def = &combo_defs[i];
+        uint8_t count = 0;
+        uint8_t position;
+
+        while (count < COMBO_MAX_KEYS && (position = pgm_read_byte(&def->keys[count])) != COMBO_END) {
+            if (position < COMBO_POSITIONS) combo_mask_set(&combo_position_index[position], i);
+            count++;
+        }
+        combo_key_counts[i] = count;
+        combo_terms[i]      = def->term;
+
+        for (uint8_t layer = 0; layer < COMBO_LAYERS; layer++) {
+            if (def->layers & COMBO_LAYER(layer)) combo_mask_set(&combo_layer_index[layer], i);
+        }
+    }
+}
+
+// Output on a layer - resolved when the combo fires, so its release matches even after a layer change
+static uint16_t combo_output(uint16_t index, uint8_t layer) {
+    const combo_def_t *def = &combo_defs[index];
+    if (def->layer_outputs && layer < COMBO_LAYERS) {
+        uint16_t output = pgm_read_word(&def->layer_outputs[layer]);
+        if (output != KC_NO) return output;
+    }
+    return def->output;
+}
+
+// Live combos on this key position - false when there are none
+static bool combo_candidates_for(keypos_t key, combo_mask_t *out) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return false;  // Not a matrix key
+    uint8_t position = pgm_read_byte(&combo_position_map[key.row][key.col]);
+    if (position >= COMBO_POSITIONS) return false;
+
+    // Layer state read once per press, not once per candidate
+    uint8_t layer = get_highest_layer(layer_state);
+    if (layer >= COMBO_LAYERS || !combos_allowed()) return false;
+
+    *out = combo_position_index[position];
+    return combo_mask_and(out, &combo_layer_index[layer]);
+}
+
+#ifdef COMBO_TELEMETRY_ENABLE
+#    include "combo_telemetry.h"
+#endif
+#ifdef RAW_ENABLE
+#    include "usage_counters.h"
+_Static_assert(COMBO_LENGTH <= USAGE_COMBOS, "Raise USAGE_COMBOS to count every combo");
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  PENDING AND ACTIVE STATE                                                                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Presses held back while they could still become a combo
+static keyevent_t     combo_pending[COMBO_MAX_KEYS];
+static uint8_t        combo_pending_count = 0;
+static combo_mask_t   combo_candidates;  // Live combos containing every pending key
+static deferred_token combo_token       = INVALID_DEFERRED_TOKEN;
+static bool           combo_replaying   = false;
+
+// Fired combos - their keys' releases are swallowed
+typedef struct {
+    uint16_t index;                 // COMBO_NONE = free slot
+    uint16_t output;                // Output for the layer it fired on
+    keypos_t keys[COMBO_MAX_KEYS];
+    uint8_t  count;
+    uint8_t  held;                  // Bit per key still down
+    bool     output_down;           // Released with the first key up
+} combo_active_t;
+
+static combo_active_t combo_active[COMBO_ACTIVE_SLOTS] = {[0 ... COMBO_ACTIVE_SLOTS - 1] = {.index = COMBO_NONE}};
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  ENGINE                                                                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static void combo_send(uint16_t index, uint16_t output, bool pressed) {
+    if (output == KC_NO) {
+        combo_action_event(index, pressed);
+        return;
+    }
+
+    // Queue behind any undecided mod-tap, exactly like a physical key
+    keyrecord_t record = {.event = MAKE_COMBOEVENT(pressed), .keycode = output};
+    action_tapping_process(record);
+}
+
+static void combo_activate(uint16_t index) {
+    uint16_t        output = combo_output(index, get_highest_layer(layer_state));
+    combo_active_t *slot   = NULL;
+#ifdef COMBO_TELEMETRY_ENABLE
+    combo_telemetry_fire(index, output, combo_pending[0].time, combo_pending[combo_pending_count - 1].time);
+#endif
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_combo(combo_pending, combo_pending_count);
+#endif
+#ifdef RAW_ENABLE
+    usage_count_combo(index);
+#endif
+    for (uint8_t i = 0; i < COMBO_ACTIVE_SLOTS; i++) {
+        if (combo_active[i].index == COMBO_NONE) {
+            slot = &combo_active[i];
+            break;
+        }
+    }
+    if (!slot) {
+        // All slots busy - tap the combo rather than drop it
+        combo_send(index, output, true);
+        combo_send(index, output, false);
+        return;
+    }
+
+    slot->index       = index;
+    slot->output      = output;
+    slot->count       = combo_pending_count;
+    slot->held        = (1 << combo_pending_count) - 1;
+    slot->output_down = true;
+    for (uint8_t i = 0; i < combo_pending_count; i++) {
+        slot->keys[i] = combo_pending[i].key;
+    }
+    combo_send(index, output, true);
+}
+
+// Pending keys didn't make a combo - run them through the normal pipeline in order
+static void combo_replay_pending(void) {
+    keyevent_t events[COMBO_MAX_KEYS];
+    uint8_t    count = combo_pending_count;
+
+    memcpy(events, combo_pending, count * sizeof(keyevent_t));
+    combo_pending_count = 0;
+
+    combo_replaying = true;
+    for (uint8_t i = 0; i < count; i++) {
+        action_exec(events[i]);
+    }
+    combo_replaying = false;
+}
+
+// Settle the pending keys: fire the combo they complete, or let them through
+static void combo_resolve(void) {
+    if (combo_token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec(combo_token);
+        combo_token = INVALID_DEFERRED_TOKEN;
+    }
+    if (!combo_pending_count) return;
+
+    // Every candidate contains all pending keys - one with no keys left over is complete
+    COMBO_MASK_FOREACH(index, &combo_candidates) {
+        if (combo_key_counts[index] == combo_pending_count) {
+            combo_activate(index);
+            combo_pending_count = 0;
+            return;
+        }
+    }
+    combo_replay_pending();
+}
+
+static uint32_t combo_term_callback(uint32_t trigger_time, void *cb_arg) {
+    PROFILE_SCOPE(PROF_COMBO);
+    combo_token = INVALID_DEFERRED_TOKEN;
+    combo_resolve();
+    return 0;
+}
+
+static bool combo_press(keyrecord_t *record) {
+    combo_mask_t candidates;
+    if (!combo_candidates_for(record->event.key, &candidates)) {
+        // Passthrough: a key in no live combo is never held back
+        combo_resolve();  // Pending keys can't grow into a combo with this one
+        return true;
+    }
+
+    if (combo_pending_count) {
+        uint16_t elapsed = TIMER_DIFF_16(record->event.time, combo_pending[0].time);
+        bool     alive   = combo_pending_count < COMBO_MAX_KEYS && combo_mask_and(&candidates, &combo_candidates);
+
+        // Strict timer: drop candidates whose term ran out since the first key
+        if (alive) {
+            COMBO_MASK_FOREACH(index, &candidates) {
+                if (elapsed > combo_terms[index]) combo_mask_clear(&candidates, index);
+            }
+            alive = combo_mask_next(&candidates, 0) != COMBO_NONE;
+        }
+        if (!alive) {
+            combo_resolve();
+            return combo_press(record);  // This key may start a combo of its own
+        }
+    } else {
+        // First key: wait for the slowest candidate's term
+        uint8_t term = 0;
+        COMBO_MASK_FOREACH(index, &candidates) {
+            if (combo_terms[index] > term) term = combo_terms[index];
+        }
+        combo_token = defer_exec(term, combo_term_callback, NULL);
+    }
+
+    combo_candidates                      = candidates;
+    combo_pending[combo_pending_count++] = record->event;
+
+    // Early fire: a complete combo that no live candidate extends can't change any more
+    bool complete = false, extendable = false;
+    COMBO_MASK_FOREACH(index, &combo_candidates) {
+        if (combo_key_counts[index] == combo_pending_count) {
+            complete = true;
+        } else {
+            extendable = true;
+        }
+    }
+    if (complete && !extendable) combo_resolve();
+
+    return false;
+}
+
+static bool combo_release(keyrecord_t *record) {
+    for (uint8_t i = 0; i < combo_pending_count; i++) {
+        if (KEYEQ(combo_pending[i].key, record->event.key)) {
+            combo_resolve();  // Released before the term: complete → fire, otherwise replay the press
+            break;
+        }
+    }
+
+    for (uint8_t s = 0; s < COMBO_ACTIVE_SLOTS; s++) {
+        combo_active_t *slot = &combo_active[s];
+        if (slot->index == COMBO_NONE) continue;
+
+        for (uint8_t i = 0; i < slot->count; i++) {
+            if (!(slot->held & (1 << i)) || !KEYEQ(slot->keys[i], record->event.key)) continue;
+
+            slot->held &= ~(1 << i);
+            if (slot->output_down) {
+                slot->output_down = false;
+                combo_send(slot->index, slot->output, false);
+            }
+            if (!slot->held) slot->index = COMBO_NONE;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Call first in pre_process_record_user - returns false when the engine holds or consumed the event
+bool process_combo_engine(uint16_t keycode, keyrecord_t *record) {
+    PROFILE_SCOPE(PROF_COMBO);
+    bool through = combo_replaying || (record->event.pressed ? combo_press(record) : combo_release(record));
+#ifdef COMBO_TELEMETRY_ENABLE
+    // Presses typed as themselves - passthroughs and replays, in the order they reach the host
+    if (through && record->event.pressed) combo_telemetry_key(keycode, record->event.key, record->event.time);
+#endif
+    return through;
+}
@@ -9,7 +9,7 @@
 
 #include QMK_KEYBOARD_H
 #include "bilateral_mods.h"
-#include "custom_keycodes.h"  // For U_NAV_* keycodes
+#include "custom_keycodes.h"  // For layers and LEADER/SMART_MOUSE
 
 /* ╔═══════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  SMART COMBOS - UROB'S POSITIONAL SYSTEM                                                          ║
@@ -20,6 +20,14 @@
  * ║  LB4=Z, LB3=X, LB2=C, LB1=D, LB0=V | RB0=K, RB1=H, RB2=,, RB3=., RB4=/                            ║
  * ╚═══════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
+// Key positions in LAYOUT_planck_grid order - Planck's centre columns are LTC/RTC, thumbs LH*/RH*
+enum combo_positions {
+    LT4, LT3, LT2, LT1, LT0, LTC,   RTC, RT0, RT1, RT2, RT3, RT4,
+    LM4, LM3, LM2, LM1, LM0, LMC,   RMC, RM0, RM1, RM2, RM3, RM4,
+    LB4, LB3, LB2, LB1, LB0, LBC,   RBC, RB0, RB1, RB2, RB3, RB4,
+    LH5, LH4, LH3, LH2, LH1, LH0,   RH0, RH1, RH2, RH3, RH4, RH5,
+};
+
 enum combo_events {
     // Navigation combos (existing)
     ESC_COMBO,       // W+F = Escape
@@ -40,12 +48,8 @@ enum combo_events {
     DEL_COMBO,       // U+Y = Delete
     LPRN_LT_COMBO,   // N+E = ( or < (RM1+RM2, shift-modified, like urob's lpar_lt)
     RPRN_GT_COMBO,   // E+I = ) or > (RM2+RM3, shift-modified, like urob's rpar_gt)
-    LBKT_LBRC_COMBO, // H+, = [ on DEF/NUM, { on NAV (layer-specific)
-    RBKT_RBRC_COMBO, // ,+. = ] on DEF/NUM, } on NAV (layer-specific)
-
-    // NAV layer versions (same physical positions, different keycodes)
-    BSPC_COMBO_NAV,  // U_NAV_BS+U_NAV_U = Backspace (same as L+U on base layer)
-    DEL_COMBO_NAV,   // U_NAV_U+U_NAV_DEL = Delete (same as U+Y on base layer)
+    LBKT_LBRC_COMBO, // H+, = [
+    RBKT_RBRC_COMBO, // ,+. = ], } on NAV (layer-specific)
 
     // urob's vertical symbol combos (left hand)
     AT_COMBO,        // W+R = @ (urob's LT3+LM3)
@@ -67,203 +71,126 @@ enum combo_events {
     SLASH_COMBO,     // E+, = / (RM2+RB2)
     PIPE_COMBO,      // I+. = | (RM3+RB3)
 
+    COMBO_LENGTH     // Sizes the engine's combo bitmasks
 };
 
-// Navigation combos
-extern const uint16_t PROGMEM esc_combo[];
-extern const uint16_t PROGMEM bspc_combo[];
-extern const uint16_t PROGMEM leader_combo[];
-extern const uint16_t PROGMEM leader_sft_combo[];
-extern const uint16_t PROGMEM mouse_combo[];
-
-// urob's horizontal combos (left hand)
-extern const uint16_t PROGMEM tab_combo[];
-extern const uint16_t PROGMEM cut_combo[];
-extern const uint16_t PROGMEM copy_combo[];
-extern const uint16_t PROGMEM paste_combo[];
-
-// urob's horizontal combos (right hand)
-extern const uint16_t PROGMEM del_combo[];
-extern const uint16_t PROGMEM lprn_lt_combo[];
-extern const uint16_t PROGMEM rprn_gt_combo[];
-extern const uint16_t PROGMEM lbkt_lbrc_combo[];
-extern const uint16_t PROGMEM rbkt_rbrc_combo[];
-
-// NAV layer versions
-extern const uint16_t PROGMEM bspc_combo_nav[];
-extern const uint16_t PROGMEM del_combo_nav[];
-
-// urob's vertical symbol combos (left hand)
-extern const uint16_t PROGMEM at_combo[];
-extern const uint16_t PROGMEM hash_combo[];
-extern const uint16_t PROGMEM dollar_combo[];
-extern const uint16_t PROGMEM percent_combo[];
-extern const uint16_t PROGMEM grave_combo[];
-extern const uint16_t PROGMEM backslash_combo[];
-extern const uint16_t PROGMEM equals_combo[];
-extern const uint16_t PROGMEM tilde_combo[];
-
-// urob's vertical symbol combos (right hand)
-extern const uint16_t PROGMEM caret_combo[];
-extern const uint16_t PROGMEM plus_combo[];
-extern const uint16_t PROGMEM star_combo[];
-extern const uint16_t PROGMEM amper_combo[];
-extern const uint16_t PROGMEM underscore_combo[];
-extern const uint16_t PROGMEM minus_combo[];
-extern const uint16_t PROGMEM slash_combo[];
-extern const uint16_t PROGMEM pipe_combo[];
-
-// Combo array declaration
-extern combo_t key_combos[];
+#include "combo_engine.h"
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  COMBO ARRAY IMPLEMENTATIONS                                                                       ║
  * ║  Physical key combinations for urob's smart combo system                                           ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
+// Matrix → combo position (the engine looks combos up by where a key is, not what it types)
+const uint8_t combo_position_map[MATRIX_ROWS][MATRIX_COLS] PROGMEM = LAYOUT_planck_grid(
+    LT4, LT3, LT2, LT1, LT0, LTC,   RTC, RT0, RT1, RT2, RT3, RT4,
+    LM4, LM3, LM2, LM1, LM0, LMC,   RMC, RM0, RM1, RM2, RM3, RM4,
+    LB4, LB3, LB2, LB1, LB0, LBC,   RBC, RB0, RB1, RB2, RB3, RB4,
+    LH5, LH4, LH3, LH2, LH1, LH0,   RH0, RH1, RH2, RH3, RH4, RH5
+);
+
 // Navigation combos
-const uint16_t PROGMEM esc_combo[] = {KC_W, KC_F, COMBO_END};
-const uint16_t PROGMEM bspc_combo[] = {KC_L, KC_U, COMBO_END};
-const uint16_t PROGMEM leader_combo[] = {HRM_S, HRM_T, COMBO_END};
-const uint16_t PROGMEM leader_sft_combo[] = {HRM_R, HRM_S, HRM_T, COMBO_END};
-const uint16_t PROGMEM mouse_combo[] = {KC_F, KC_P, COMBO_END};
+const uint8_t PROGMEM esc_combo[] = {LT3, LT2, COMBO_END};
+const uint8_t PROGMEM bspc_combo[] = {RT1, RT2, COMBO_END};
+const uint8_t PROGMEM leader_combo[] = {LM2, LM1, COMBO_END};
+const uint8_t PROGMEM leader_sft_combo[] = {LM3, LM2, LM1, COMBO_END};
+const uint8_t PROGMEM mouse_combo[] = {LT2, LT1, COMBO_END};
 
 // urob's horizontal combos (left hand)
-const uint16_t PROGMEM tab_combo[] = {HRM_R, HRM_S, COMBO_END};
-const uint16_t PROGMEM cut_combo[] = {KC_X, KC_D, COMBO_END};
-const uint16_t PROGMEM copy_combo[] = {KC_X, KC_C, COMBO_END};
-const uint16_t PROGMEM paste_combo[] = {KC_C, KC_D, COMBO_END};
+const uint8_t PROGMEM tab_combo[] = {LM3, LM2, COMBO_END};
+const uint8_t PROGMEM cut_combo[] = {LB3, LB1, COMBO_END};
+const uint8_t PROGMEM copy_combo[] = {LB3, LB2, COMBO_END};
+const uint8_t PROGMEM paste_combo[] = {LB2, LB1, COMBO_END};
 
 // urob's horizontal combos (right hand)
-const uint16_t PROGMEM del_combo[] = {KC_U, KC_Y, COMBO_END};
-const uint16_t PROGMEM lprn_lt_combo[] = {HRM_N, HRM_E, COMBO_END};
-const uint16_t PROGMEM rprn_gt_combo[] = {HRM_E, HRM_I, COMBO_END};
-const uint16_t PROGMEM lbkt_lbrc_combo[] = {KC_H, KC_COMM, COMBO_END};
-const uint16_t PROGMEM rbkt_rbrc_combo[] = {KC_COMM, KC_DOT, COMBO_END};
-
-// NAV layer versions (same physical positions, U_NAV_* keycodes)
-const uint16_t PROGMEM bspc_combo_nav[] = {U_NAV_BS, U_NAV_U, COMBO_END};
-const uint16_t PROGMEM del_combo_nav[] = {U_NAV_U, U_NAV_DEL, COMBO_END};
+const uint8_t PROGMEM del_combo[] = {RT2, RT3, COMBO_END};
+const uint8_t PROGMEM lprn_lt_combo[] = {RM1, RM2, COMBO_END};
+const uint8_t PROGMEM rprn_gt_combo[] = {RM2, RM3, COMBO_END};
+const uint8_t PROGMEM lbkt_lbrc_combo[] = {RB1, RB2, COMBO_END};
+const uint8_t PROGMEM rbkt_rbrc_combo[] = {RB2, RB3, COMBO_END};
 
 // urob's vertical symbol combos (left hand)
-const uint16_t PROGMEM at_combo[] = {KC_W, HRM_R, COMBO_END};
-const uint16_t PROGMEM hash_combo[] = {KC_F, HRM_S, COMBO_END};
-const uint16_t PROGMEM dollar_combo[] = {KC_P, HRM_T, COMBO_END};
-const uint16_t PROGMEM percent_combo[] = {KC_B, KC_G, COMBO_END};
-const uint16_t PROGMEM grave_combo[] = {HRM_R, KC_X, COMBO_END};
-const uint16_t PROGMEM backslash_combo[] = {HRM_S, KC_C, COMBO_END};
-const uint16_t PROGMEM equals_combo[] = {HRM_T, KC_D, COMBO_END};
-const uint16_t PROGMEM tilde_combo[] = {KC_G, KC_V, COMBO_END};
+const uint8_t PROGMEM at_combo[] = {LT3, LM3, COMBO_END};
+const uint8_t PROGMEM hash_combo[] = {LT2, LM2, COMBO_END};
+const uint8_t PROGMEM dollar_combo[] = {LT1, LM1, COMBO_END};
+const uint8_t PROGMEM percent_combo[] = {LT0, LM0, COMBO_END};
+const uint8_t PROGMEM grave_combo[] = {LM3, LB3, COMBO_END};
+const uint8_t PROGMEM backslash_combo[] = {LM2, LB2, COMBO_END};
+const uint8_t PROGMEM equals_combo[] = {LM1, LB1, COMBO_END};
+const uint8_t PROGMEM tilde_combo[] = {LM0, LB0, COMBO_END};
 
 // urob's vertical symbol combos (right hand)
-const uint16_t PROGMEM caret_combo[] = {KC_J, KC_M, COMBO_END};
-const uint16_t PROGMEM plus_combo[] = {KC_L, HRM_N, COMBO_END};
-const uint16_t PROGMEM star_combo[] = {KC_U, HRM_E, COMBO_END};
-const uint16_t PROGMEM amper_combo[] = {KC_Y, HRM_I, COMBO_END};
-const uint16_t PROGMEM underscore_combo[] = {KC_M, KC_K, COMBO_END};
-const uint16_t PROGMEM minus_combo[] = {HRM_N, KC_H, COMBO_END};
-const uint16_t PROGMEM slash_combo[] = {HRM_E, KC_COMM, COMBO_END};
-const uint16_t PROGMEM pipe_combo[] = {HRM_I, KC_DOT, COMBO_END};
-
-combo_t key_combos[] = {
-    [ESC_COMBO] = COMBO(esc_combo, KC_ESC),
-    [BSPC_COMBO] = COMBO(bspc_combo, KC_BSPC),
-    [LEADER_COMBO] = COMBO(leader_combo, LEADER),
-    [LEADER_SFT_COMBO] = COMBO(leader_sft_combo, LEADER_SFT),
-    [MOUSE_COMBO] = COMBO(mouse_combo, SMART_MOUSE),
-
-    [TAB_COMBO] = COMBO(tab_combo, KC_TAB),
-    [CUT_COMBO] = COMBO(cut_combo, LGUI(KC_X)),
-    [COPY_COMBO] = COMBO(copy_combo, LGUI(KC_C)),
-    [PASTE_COMBO] = COMBO(paste_combo, LGUI(KC_V)),
-
-    [DEL_COMBO] = COMBO(del_combo, KC_DEL),
-    [LPRN_LT_COMBO] = COMBO_ACTION(lprn_lt_combo),
-    [RPRN_GT_COMBO] = COMBO_ACTION(rprn_gt_combo),
-    [LBKT_LBRC_COMBO] = COMBO_ACTION(lbkt_lbrc_combo),
-    [RBKT_RBRC_COMBO] = COMBO_ACTION(rbkt_rbrc_combo),
-
-    // NAV layer versions (trigger combos even when hold-tap keys are in those positions)
-    [BSPC_COMBO_NAV] = COMBO(bspc_combo_nav, KC_BSPC),
-    [DEL_COMBO_NAV] = COMBO(del_combo_nav, KC_DEL),
-
-    [AT_COMBO] = COMBO(at_combo, KC_AT),
-    [HASH_COMBO] = COMBO(hash_combo, KC_HASH),
-    [DOLLAR_COMBO] = COMBO(dollar_combo, KC_DLR),
-    [PERCENT_COMBO] = COMBO(percent_combo, KC_PERC),
-    [GRAVE_COMBO] = COMBO(grave_combo, KC_GRV),
-    [BACKSLASH_COMBO] = COMBO(backslash_combo, KC_BSLS),
-    [EQUALS_COMBO] = COMBO(equals_combo, KC_EQL),
-    [TILDE_COMBO] = COMBO(tilde_combo, KC_TILD),
-
-    [CARET_COMBO] = COMBO(caret_combo, KC_CIRC),
-    [PLUS_COMBO] = COMBO(plus_combo, KC_PLUS),
-    [STAR_COMBO] = COMBO(star_combo, KC_ASTR),
-    [AMPER_COMBO] = COMBO(amper_combo, KC_AMPR),
-    [UNDERSCORE_COMBO] = COMBO(underscore_combo, KC_UNDS),
-    [MINUS_COMBO] = COMBO(minus_combo, KC_MINS),
-    [SLASH_COMBO] = COMBO(slash_combo, KC_SLSH),
-    [PIPE_COMBO] = COMBO(pipe_combo, KC_PIPE),
-};
+const uint8_t PROGMEM caret_combo[] = {RT0, RM0, COMBO_END};
+const uint8_t PROGMEM plus_combo[] = {RT1, RM1, COMBO_END};
+const uint8_t PROGMEM star_combo[] = {RT2, RM2, COMBO_END};
+const uint8_t PROGMEM amper_combo[] = {RT3, RM3, COMBO_END};
+const uint8_t PROGMEM underscore_combo[] = {RM0, RB0, COMBO_END};
+const uint8_t PROGMEM minus_combo[] = {RM1, RB1, COMBO_END};
+const uint8_t PROGMEM slash_combo[] = {RM2, RB2, COMBO_END};
+const uint8_t PROGMEM pipe_combo[] = {RM3, RB3, COMBO_END};
 
 /* ╔═════════════════════════════════════════════════════════════════════════════╗
- * ║  COMBO TIMING AND CONTROL FUNCTIONS                                         ║
+ * ║  COMBO TABLE - OUTPUT, LAYERS AND TIMING                                    ║
  * ║  Smart timing to work with bilateral homerow mods                           ║
  * ╚═════════════════════════════════════════════════════════════════════════════╝ */
 
-uint16_t get_combo_term(uint16_t index, combo_t *combo) {
-    switch (index) {
-        case ESC_COMBO:
-        case BSPC_COMBO:
-        case BSPC_COMBO_NAV:  // NAV layer version needs same fast timing
-        case MOUSE_COMBO:
-            return 15;
-
-        case LEADER_SFT_COMBO:
-            return 25;
-
-        case HASH_COMBO:
-        case DOLLAR_COMBO:
-        case PERCENT_COMBO:
-        case PLUS_COMBO:
-        case STAR_COMBO:
-        case AMPER_COMBO:
-            return 30;
-
-        default:
-            return COMBO_TERM;  // DEL_COMBO_NAV uses default 18ms
-    }
-}
-
-bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record) {
-    uint8_t current_layer = get_highest_layer(layer_state);
-
-    if (get_highest_layer(default_layer_state) == _GAMING) {
-        return false;
-    }
-
-    switch (combo_index) {
-        // Base layer combos - don't trigger on NAV layer (NAV versions will handle it)
-        case BSPC_COMBO:
-        case DEL_COMBO:
-            return current_layer != _NAV;
-
-        // NAV layer combos - only trigger on NAV layer
-        case BSPC_COMBO_NAV:
-        case DEL_COMBO_NAV:
-            return current_layer == _NAV;
-
-        case LBKT_LBRC_COMBO:
-        case RBKT_RBRC_COMBO:
-            return (current_layer == _DEF || current_layer == _NUM || current_layer == _NAV);
-
-        case LPRN_LT_COMBO:
-        case RPRN_GT_COMBO:
-            return true;
+// Where a combo is live - by position, so each mask lists the layers that leave its keys transparent
+// (the same set the keycode combos fired on). BSPC and DEL also fire over NAV's U_NAV hold-taps
+#define ALPHA_LAYERS   COMBO_LAYER(_DEF)                                         // Digits on NUM, mods on NAV
+#define TEXT_LAYERS    (ALPHA_LAYERS | COMBO_LAYER(_NUM))                        // Right hand - NUM is transparent
+#define EDIT_LAYERS    (TEXT_LAYERS | COMBO_LAYER(_NAV))                         // BSPC, DEL
+#define BRACKET_LAYERS (TEXT_LAYERS | COMBO_LAYER(_SYS))                         // H , . row
+#define SYS_LAYERS     (ALPHA_LAYERS | COMBO_LAYER(_SYS))                        // F S C column
+#define MOUSE_LAYERS   (ALPHA_LAYERS | COMBO_LAYER(_MOUSE))                      // W F P row
+#define CLIP_LAYERS    (MOUSE_LAYERS | COMBO_LAYER(_NAV))                        // X C D row
+#define INNER_LAYERS   (BRACKET_LAYERS | COMBO_LAYER(_FN))                       // J M K column
+#define COMMA_LAYERS   (BRACKET_LAYERS | COMBO_LAYER(_NAV))                      // , . - transparent on NAV too
+#define EDGE_LAYERS    (INNER_LAYERS | COMBO_LAYER(_NAV) | COMBO_LAYER(_MOUSE))  // B G V column
+
+// Per-layer outputs - unlisted layers use the combo's default output
+const uint16_t PROGMEM rbkt_rbrc_outputs[COMBO_LAYERS] = {[_NAV] = KC_RCBR};
+
+const combo_def_t combo_defs[COMBO_LENGTH] = {
+    //                    keys              output       per-layer          layers          term
+    [ESC_COMBO]        = {esc_combo,        KC_ESC,      NULL,              MOUSE_LAYERS,   15},
+    [BSPC_COMBO]       = {bspc_combo,       KC_BSPC,     NULL,              EDIT_LAYERS,    15},
+    [LEADER_COMBO]     = {leader_combo,     LEADER,      NULL,              ALPHA_LAYERS,   COMBO_TERM},
+    [LEADER_SFT_COMBO] = {leader_sft_combo, LEADER_SFT,  NULL,              ALPHA_LAYERS,   25},
+    [MOUSE_COMBO]      = {mouse_combo,      SMART_MOUSE, NULL,              MOUSE_LAYERS,   15},
+
+    [TAB_COMBO]        = {tab_combo,        KC_TAB,      NULL,              ALPHA_LAYERS,   COMBO_TERM},
+    [CUT_COMBO]        = {cut_combo,        LGUI(KC_X),  NULL,              CLIP_LAYERS,    COMBO_TERM},
+    [COPY_COMBO]       = {copy_combo,       LGUI(KC_C),  NULL,              CLIP_LAYERS,    COMBO_TERM},
+    [PASTE_COMBO]      = {paste_combo,      LGUI(KC_V),  NULL,              CLIP_LAYERS,    COMBO_TERM},
+
+    [DEL_COMBO]        = {del_combo,        KC_DEL,      NULL,              EDIT_LAYERS,    COMBO_TERM},
+    [LPRN_LT_COMBO]    = {lprn_lt_combo,    KC_NO,       NULL,              TEXT_LAYERS,    COMBO_TERM},  // Shift-morph action
+    [RPRN_GT_COMBO]    = {rprn_gt_combo,    KC_NO,       NULL,              TEXT_LAYERS,    COMBO_TERM},
+    [LBKT_LBRC_COMBO]  = {lbkt_lbrc_combo,  KC_LBRC,     NULL,              BRACKET_LAYERS, COMBO_TERM},
+    [RBKT_RBRC_COMBO]  = {rbkt_rbrc_combo,  KC_RBRC,     rbkt_rbrc_outputs, COMMA_LAYERS,   COMBO_TERM},
+
+    [AT_COMBO]         = {at_combo,         KC_AT,       NULL,              ALPHA_LAYERS,   COMBO_TERM},
+    [HASH_COMBO]       = {hash_combo,       KC_HASH,     NULL,              SYS_LAYERS,     30},
+    [DOLLAR_COMBO]     = {dollar_combo,     KC_DLR,      NULL,              ALPHA_LAYERS,   30},
+    [PERCENT_COMBO]    = {percent_combo,    KC_PERC,     NULL,              EDGE_LAYERS,    30},
+    [GRAVE_COMBO]      = {grave_combo,      KC_GRV,      NULL,              ALPHA_LAYERS,   COMBO_TERM},
+    [BACKSLASH_COMBO]  = {backslash_combo,  KC_BSLS,     NULL,              SYS_LAYERS,     COMBO_TERM},
+    [EQUALS_COMBO]     = {equals_combo,     KC_EQL,      NULL,              ALPHA_LAYERS,   COMBO_TERM},
+    [TILDE_COMBO]      = {tilde_combo,      KC_TILD,     NULL,              EDGE_LAYERS,    COMBO_TERM},
+
+    [CARET_COMBO]      = {caret_combo,      KC_CIRC,     NULL,              INNER_LAYERS,   COMBO_TERM},
+    [PLUS_COMBO]       = {plus_combo,       KC_PLUS,     NULL,              TEXT_LAYERS,    30},
+    [STAR_COMBO]       = {star_combo,       KC_ASTR,     NULL,              TEXT_LAYERS,    30},
+    [AMPER_COMBO]      = {amper_combo,      KC_AMPR,     NULL,              TEXT_LAYERS,    30},
+    [UNDERSCORE_COMBO] = {underscore_combo, KC_UNDS,     NULL,              INNER_LAYERS,   COMBO_TERM},
+    [MINUS_COMBO]      = {minus_combo,      KC_MINS,     NULL,              TEXT_LAYERS,    COMBO_TERM},
+    [SLASH_COMBO]      = {slash_combo,      KC_SLSH,     NULL,              TEXT_LAYERS,    COMBO_TERM},
+    [PIPE_COMBO]       = {pipe_combo,       KC_PIPE,     NULL,              TEXT_LAYERS,    COMBO_TERM},
+};
 
-        default:
-            return true;
-    }
+// No combos at all while gaming is the default layer
+bool combos_allowed(void) {
+    return get_highest_layer(default_layer_state) != _GAMING;
 }
 
 /* ╔═════════════════════════════════════════════════════════════════════════════╗
@@ -271,67 +198,36 @@ bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode
  * ║  Implements lpar_lt and rpar_gt mod-morph behaviors                         ║
  * ╚═════════════════════════════════════════════════════════════════════════════╝ */
 
-void process_combo_event(uint16_t combo_index, bool pressed) {
-    uint8_t current_layer = get_highest_layer(layer_state);
+void combo_action_event(uint16_t combo_index, bool pressed) {
+    if (!pressed) return;
+
     uint8_t saved_mods = get_mods();
     uint8_t oneshot_mods = get_oneshot_mods();
     bool shift_held = (saved_mods | oneshot_mods) & MOD_MASK_SHIFT;
 
     switch (combo_index) {
         case LPRN_LT_COMBO:
-            if (pressed) {
-                if (current_layer == _NAV) {
-                    tap_code16(KC_LT);
-                } else {
-                    clear_mods();
-                    clear_oneshot_mods();
-                    if (shift_held) {
-                        tap_code16(KC_LT);
-                    } else {
-                        tap_code16(KC_LPRN);
-                    }
-                    set_mods(saved_mods);
-                    set_oneshot_mods(oneshot_mods);
-                }
+            clear_mods();
+            clear_oneshot_mods();
+            if (shift_held) {
+                tap_code16(KC_LT);
+            } else {
+                tap_code16(KC_LPRN);
             }
+            set_mods(saved_mods);
+            set_oneshot_mods(oneshot_mods);
             break;
 
         case RPRN_GT_COMBO:
-            if (pressed) {
-                if (current_layer == _NAV) {
-                    tap_code16(KC_GT);
-                } else {
-                    clear_mods();
-                    clear_oneshot_mods();
-                    if (shift_held) {
-                        tap_code16(KC_GT);
-                    } else {
-                        tap_code16(KC_RPRN);
-                    }
-                    set_mods(saved_mods);
-                    set_oneshot_mods(oneshot_mods);
-                }
-            }
-            break;
-
-        case LBKT_LBRC_COMBO:
-            if (pressed) {
-                if (current_layer == _NAV) {
-                    tap_code16(KC_LCBR);
-                } else {
-                    tap_code16(KC_LBRC);
-                }
-            }
-            break;
-
-        case RBKT_RBRC_COMBO:
-            if (pressed) {
-                if (current_layer == _NAV) {
-                    tap_code16(KC_RCBR);
-                } else {
-                    tap_code16(KC_RBRC);
-                }
+            clear_mods();
+            clear_oneshot_mods();
+            if (shift_held) {
+                tap_code16(KC_GT);
+            } else {
+                tap_code16(KC_RPRN);
             }
+            set_mods(saved_mods);
+            set_oneshot_mods(oneshot_mods);
             break;
     }
 }
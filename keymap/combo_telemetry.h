@@ -0,0 +1,195 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * COMBO TELEMETRY
+ * Press-gap histograms per combo, near-miss and misfire detection, optional term auto-tuning
+ * Included by combo_engine.h when COMBO_TELEMETRY_ENABLE is defined
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "custom_keycodes.h"  // For U_NAV_BS
+#include "event_log.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  GAP HISTOGRAMS                                                                                    ║
+ * ║  Gap = first key to last key of a combo, bucketed per combo - saturating counters                  ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Tuning knobs (override in config.h)
+#ifndef COMBO_HIST_BUCKETS
+#    define COMBO_HIST_BUCKETS 10          // Last bucket catches everything slower
+#endif
+#ifndef COMBO_HIST_BUCKET_MS
+#    define COMBO_HIST_BUCKET_MS 5         // 0-4, 5-9, ... 45+ ms
+#endif
+#ifndef COMBO_NEAR_MISS_WINDOW
+#    define COMBO_NEAR_MISS_WINDOW 30      // A combo pair this far past its term may be a near-miss
+#endif
+#ifndef COMBO_CORRECTION_WINDOW
+#    define COMBO_CORRECTION_WINDOW 600    // Backspace within this time counts as a correction
+#endif
+#ifndef COMBO_TUNE_STEP
+#    define COMBO_TUNE_STEP 2              // ms per auto-tune adjustment
+#endif
+#ifndef COMBO_TUNE_MIN
+#    define COMBO_TUNE_MIN 10              // Never faster than this
+#endif
+#ifndef COMBO_TUNE_MAX
+#    define COMBO_TUNE_MAX 40              // Never slower than this
+#endif
+
+typedef struct {
+    uint16_t hits[COMBO_HIST_BUCKETS];         // Fired
+    uint16_t near_misses[COMBO_HIST_BUCKETS];  // Typed just too slowly, then backspaced
+    uint16_t misfires;                         // Fired, then backspaced
+} combo_stats_t;
+
+static combo_stats_t combo_stats[COMBO_LENGTH];
+
+// Combo armed for a Backspace correction
+static uint16_t combo_suspect       = COMBO_NONE;
+static uint16_t combo_suspect_gap   = 0;
+static uint16_t combo_suspect_time  = 0;
+static bool     combo_suspect_fired = false;  // true: misfire check, false: near-miss check
+
+// Previous press typed as itself - one half of a possible near-miss
+static keypos_t combo_last_key;
+static uint16_t combo_last_time  = 0;
+static bool     combo_last_valid = false;
+
+static inline void combo_count(uint16_t *counter) {
+    if (*counter < UINT16_MAX) (*counter)++;
+}
+
+static inline uint8_t combo_hist_bucket(uint16_t gap) {
+    uint16_t bucket = gap / COMBO_HIST_BUCKET_MS;
+    return bucket < COMBO_HIST_BUCKETS ? bucket : COMBO_HIST_BUCKETS - 1;
+}
+
+static inline bool combo_is_correction(uint16_t keycode) {
+    return keycode == KC_BSPC || keycode == U_NAV_BS;
+}
+
+// RAM only - the dump prints the learned terms to copy into combo_defs[]
+static void combo_tune(uint16_t index, int8_t step) {
+    #ifdef COMBO_AUTO_TUNE
+        int16_t term = combo_terms[index] + step;
+        if (term < COMBO_TUNE_MIN || term > COMBO_TUNE_MAX) return;
+        combo_terms[index] = term;
+        LOG_INFO(EV_COMBO_TERM, index, term);
+    #endif
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  CORRECTION DETECTION                                                                              ║
+ * ║  Combo fired, then Backspace             → typing rolled into it → shorten its term                ║
+ * ║  Combo pair just past the term, then BS  → chord was too slow → lengthen its term                  ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// First key after an armed combo settles it either way
+static void combo_telemetry_correction(uint16_t keycode, uint16_t time) {
+    if (combo_suspect == COMBO_NONE) return;
+
+    if (combo_is_correction(keycode) && TIMER_DIFF_16(time, combo_suspect_time) < COMBO_CORRECTION_WINDOW) {
+        combo_stats_t *stats = &combo_stats[combo_suspect];
+        if (combo_suspect_fired) {
+            combo_count(&stats->misfires);
+            // Only a roll near the term is fixed by a shorter one - a true chord misfire is not
+            if (combo_suspect_gap * 2 > combo_terms[combo_suspect]) combo_tune(combo_suspect, -COMBO_TUNE_STEP);
+        } else {
+            combo_count(&stats->near_misses[combo_hist_bucket(combo_suspect_gap)]);
+            combo_tune(combo_suspect, +COMBO_TUNE_STEP);
+        }
+    }
+    combo_suspect = COMBO_NONE;
+}
+
+// Engine hook: a combo fired
+static void combo_telemetry_fire(uint16_t index, uint16_t output, uint16_t first_time, uint16_t last_time) {
+    uint16_t gap = TIMER_DIFF_16(last_time, first_time);
+
+    combo_telemetry_correction(output, last_time);  // The Backspace combo corrects too
+    combo_count(&combo_stats[index].hits[combo_hist_bucket(gap)]);
+    combo_last_valid = false;                       // Its keys can't pair into a near-miss
+
+    if (!combo_is_correction(output)) {             // Repeated Backspace isn't a misfire
+        combo_suspect       = index;
+        combo_suspect_gap   = gap;
+        combo_suspect_time  = last_time;
+        combo_suspect_fired = true;
+    }
+}
+
+// Engine hook: a press went through as itself
+static void combo_telemetry_key(uint16_t keycode, keypos_t key, uint16_t time) {
+    combo_telemetry_correction(keycode, time);
+
+    // Near-miss candidate: this key and the previous one are a two-key combo, pressed just too slowly
+    if (combo_last_valid && !KEYEQ(key, combo_last_key)) {
+        uint16_t     gap = TIMER_DIFF_16(time, combo_last_time);
+        combo_mask_t pair, previous;
+
+        if (combo_candidates_for(key, &pair) && combo_candidates_for(combo_last_key, &previous) &&
+            combo_mask_and(&pair, &previous)) {
+            COMBO_MASK_FOREACH(index, &pair) {
+                if (combo_key_counts[index] == 2 && gap > combo_terms[index] &&
+                    gap <= combo_terms[index] + COMBO_NEAR_MISS_WINDOW) {
+                    combo_suspect       = index;
+                    combo_suspect_gap   = gap;
+                    combo_suspect_time  = time;
+                    combo_suspect_fired = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    combo_last_key   = key;
+    combo_last_time  = time;
+    combo_last_valid = true;
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EXPORT                                                                                            ║
+ * ║  CMB_STATS dumps to the console (hid_listen / qmk console), Shift+CMB_STATS clears                 ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Shortest term covering 95% of hits and near-misses - 0 without data
+static uint8_t combo_fit_term(const combo_stats_t *stats) {
+    uint32_t total = 0, seen = 0;
+    for (uint8_t b = 0; b < COMBO_HIST_BUCKETS; b++) {
+        total += stats->hits[b] + stats->near_misses[b];
+    }
+    if (!total) return 0;
+
+    for (uint8_t b = 0; b < COMBO_HIST_BUCKETS; b++) {
+        seen += stats->hits[b] + stats->near_misses[b];
+        if (seen * 20 >= total * 19) return (b + 1) * COMBO_HIST_BUCKET_MS;
+    }
+    return COMBO_HIST_BUCKETS * COMBO_HIST_BUCKET_MS;
+}
+
+void combo_telemetry_dump(void) {
+    #ifdef CONSOLE_ENABLE
+        uprintf("Combo gaps, %u ms buckets: hits | near-misses\n", COMBO_HIST_BUCKET_MS);
+        for (uint16_t i = 0; i < COMBO_LENGTH; i++) {
+            const combo_stats_t *stats = &combo_stats[i];
+            uint8_t              fit   = combo_fit_term(stats);
+            if (!fit && !stats->misfires) continue;
+
+            uprintf("%2u term=%2u fit=%2u:", i, combo_terms[i], fit);
+            for (uint8_t b = 0; b < COMBO_HIST_BUCKETS; b++) uprintf(" %u", stats->hits[b]);
+            uprintf(" |");
+            for (uint8_t b = 0; b < COMBO_HIST_BUCKETS; b++) uprintf(" %u", stats->near_misses[b]);
+            uprintf(" misfires=%u\n", stats->misfires);
+        }
+    #endif
+}
+
+void combo_telemetry_reset(void) {
+    memset(combo_stats, 0, sizeof(combo_stats));
+    combo_suspect    = COMBO_NONE;
+    combo_last_valid = false;
+}
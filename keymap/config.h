@@ -22,19 +22,22 @@
  * - Right hand mods: N=Ctrl, E=Shift, I=Alt, O=Gui
  *
  * Key principle: When you press a mod on one hand, then a key on the OTHER hand,
- * the mod activates immediately. Same-hand combinations require full timeout (280ms).
+ * the mod activates immediately. A key on the SAME hand resolves the mod as a tap immediately.
+ * Hand assignment per matrix position lives in chordal_hold_layout (bilateral_mods.h).
  *
  * Differences from urobs' ZMK config:
- * - ZMK has "require-prior-idle-ms" (150ms) - QMK doesn't have direct equivalent
- * - We use QUICK_TAP_TERM (150ms) + disabled RETRO_TAPPING as closest approximation
- * - PERMISSIVE_HOLD + HOLD_ON_OTHER_KEY_PRESS enable bilateral behavior
+ * - ZMK's "require-prior-idle-ms" (150ms) maps to QMK's FLOW_TAP_TERM (HRMs) plus a
+ *   last-alpha timestamp checked by SMART_SPC/SMART_NUM (smart_behaviors.h)
+ * - QUICK_TAP_TERM (150ms) + disabled RETRO_TAPPING handle repeated taps of the same key
+ * - CHORDAL_HOLD (positional) + HOLD_ON_OTHER_KEY_PRESS enable bilateral behavior
  * ═══════════════════════════════════════════════════════════════════════════════════════════════════ */
 
 // Urob's timing approach - 280ms base, same as ZMK config
 // Large tapping term reduces timing sensitivity
 #define TAPPING_TERM 280
 
-// Enable per-key configuration
+// Enable per-key configuration - homerow mod terms adapt per finger (adaptive_term.h)
+// Learned offsets live in the user EEPROM word; EE_CLR resets them to TAPPING_TERM
 #define TAPPING_TERM_PER_KEY
 
 // Aggressive hold behavior for bilateral (opposite-hand) combinations
@@ -43,17 +46,39 @@
 #define PERMISSIVE_HOLD
 #define PERMISSIVE_HOLD_PER_KEY
 
+// Positional hold-tap: a same-hand key press settles the homerow mod as a tap at once
+// Equivalent to urobs' hold-trigger-key-positions (hand table in bilateral_mods.h)
+#define CHORDAL_HOLD
+
 // Immediate hold when another key is pressed (crucial for bilateral mods)
-// Similar to urobs' positional hold-tap behavior
+// Per key: the homerow mods only (bilateral_mods.h) - opposite-hand and thumb presses get here, same-hand
+// ones were already settled as taps by CHORDAL_HOLD
 #define HOLD_ON_OTHER_KEY_PRESS
 #define HOLD_ON_OTHER_KEY_PRESS_PER_KEY
 
-// Quick tap term - closest QMK equivalent to urobs' require-prior-idle-ms (150ms)
-// Prevents repeated taps of same key from triggering hold
+// Quick tap term - prevents repeated taps of same key from triggering hold
 // Reduced from 175ms to 150ms to better match urobs' fast typing handling
 #define QUICK_TAP_TERM 150
 #define QUICK_TAP_TERM_PER_KEY
 
+// NAV hold-tap streak - re-pressing the same U_NAV_* key within 150ms repeats it instead of holding
+#define STREAK_TIMEOUT 150
+
+// Firmware auto-repeat while a NAV streak key is held (same feel on every host)
+#define STREAK_REPEAT_DELAY 200         // Delay before the first repeat
+#define STREAK_REPEAT_INTERVAL 50       // First repeat interval (20 per second)
+#define STREAK_REPEAT_INTERVAL_MIN 10   // Top speed (100 per second)
+#define STREAK_REPEAT_ACCEL 4           // ms shaved off the interval after every repeat
+
+// Leader sequences (leader_sequences.txt) - time to type the next key, and how long a complete
+// sequence that also prefixes a longer one (a → ä vs a g → à) waits before firing
+#define LEADER_TIMEOUT 3000
+#define LEADER_PREFIX_TIMEOUT 300
+
+// urobs' require-prior-idle-ms (150ms): a homerow mod pressed within this time of the
+// previous alpha key is settled as a tap at press time - zero tap-hold latency mid-word
+#define FLOW_TAP_TERM 150
+
 /* ═══════════════════════════════════════════════════════════════════════════════════════════════════
  * UNICODE CONFIGURATION
  * macOS requires 4-digit hex codes - QMK handles this automatically
@@ -70,12 +95,28 @@
 #define TAPPING_TOGGLE 2
 
 // Smart Combos - urob's symbol system (Colemak optimized) - using urob's fast timing
-#define COMBO_COUNT 32  // 30 base combos + 2 NAV layer versions (BSPC_NAV, DEL_NAV)
-#define COMBO_TERM 18           // 18ms like urob's fast combos
-#define COMBO_MUST_HOLD_MODS    // Don't interfere with homerow mods
-#define COMBO_HOLD_TERM 150     // Hold time for combo holds
-#define COMBO_STRICT_TIMER      // More precise timing - start timer on first key
-#define COMBO_TERM_PER_COMBO    // Allow per-combo timing configuration
+// Indexed engine in combo_engine.h (QMK's COMBO_ENABLE is off); per-combo terms live in combo_defs[]
+#define COMBO_TERM 18           // 18ms like urob's fast combos - timer starts on the first key
+
+// Combo telemetry (combo_telemetry.h) - per-combo press-gap histograms, near-misses and misfires,
+// dumped to the console with CMB_STATS (SYS layer)
+#define COMBO_TELEMETRY_ENABLE
+// Let corrections retune each combo's term between COMBO_TUNE_MIN/MAX (RAM only - copy the dumped
+// terms into combo_defs[] to keep them)
+// #define COMBO_AUTO_TUNE
+
+// Key-to-report latency tracer (latency_trace.h) - scan time to HID report change per path
+// (tap, hold, combo, override, MIDI, gaming), dumped to the console with LAT_STATS (SYS layer)
+// #define LATENCY_TRACE_ENABLE
+
+// Tournament mode (tournament.h) - while GAMING is the default layer, gaming-layer keys skip the combo
+// engine, hold-tap buffer, smart behaviors, key overrides and logging (SOCD only), NKRO is forced on and
+// RGB (the red GAMING corners included) and music mode are paused. Comment out to measure the full
+// pipeline's "gaming" latency for comparison
+#define TOURNAMENT_MODE
+
+// 1ms (1000Hz) keyboard endpoint polling - fixed in the USB descriptor, so it applies in every mode
+#define USB_POLLING_INTERVAL_MS 1
 
 // One shot settings
 #define ONESHOT_TAP_TOGGLE 2
@@ -105,7 +146,23 @@
  * ═══════════════════════════════════════════════════════════════════════════════════════════════════ */
 
 // Debug options (comment out for production)
-// #define DEBUG_MATRIX_SCAN_RATE
+// #define DEBUG_MATRIX_SCAN_RATE      // QMK's scans-per-second print, no breakdown
+
+// Binary event log (event_log.h) - key, MIDI and term-tuning diagnostics are recorded as binary records
+// and printed from housekeeping once typing pauses. 0 off, 1 error, 2 info, 3 debug (every key press and note)
+#define EVENT_LOG_LEVEL 3
+
+// Scan-loop profiler (scan_profiler.h) - min/avg/max loop time split by subsystem every 10s on the
+// console, plus a line for each loop over the budget naming the slowest section (DWT cycle counter)
+// Also prints cycles and ns per process_smart_behaviors call (alpha, hold-tap, leader, gaming) as JSON
+// lines for before/after comparisons - `make bench` measures the same calls on the host, with instructions
+// #define SCAN_PROFILER_ENABLE
+// #define PROFILER_BUDGET_US 1000
+
+// Latency budgets (latency_budget.h) - the build fails if COMBO_TERM or TAPPING_TERM (or the ceilings
+// of auto-tune and the adaptive term) would hold a key back longer than its path's budget
+#define LATENCY_BUDGET_COMBO 40
+#define LATENCY_BUDGET_HOLD 350
 
 // Memory optimization - 8 layers (COLEMAK, QWERTY, NUM, SYM, FN, ADJUST, NAV, MIDI)
 #define LAYER_STATE_8BIT  // Use 8-bit layer state for <=8 layers
@@ -125,7 +182,11 @@
 // #define RETRO_TAPPING            // DISABLED: Can cause unexpected taps after holds
 
 // RGB Matrix integration for homerow mod feedback
-#ifdef RGB_MATRIX_ENABLE
+#if defined(RGB_MATRIX_ENABLE) && defined(LEAN_RGB)
+    // Lean build profiles (rules.mk): static effects only - no per-key or per-frame animation work
+    #define ENABLE_RGB_MATRIX_SOLID_COLOR
+    #define ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+#elif defined(RGB_MATRIX_ENABLE)
     #define RGB_MATRIX_KEYPRESSES
     #define RGB_MATRIX_KEYRELEASES
     #define RGB_MATRIX_FRAMEBUFFER_EFFECTS
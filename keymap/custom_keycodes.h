@@ -55,6 +55,8 @@ enum planck_keycodes {
     U_NAV_R,      // Tap: Right, Hold: End
     U_NAV_BS,     // Tap: Backspace, Hold: Ctrl+Backspace
     U_NAV_DEL,    // Tap: Delete, Hold: Ctrl+Delete
+    CMB_STATS,    // Dump combo timing histograms to the console, Shift: clear them
+    LAT_STATS,    // Dump key-to-report latency histograms to the console, Shift: clear them
 };
 
 /* ╔══════════════════════════════════════════════════════════╗
@@ -77,7 +79,11 @@ enum {
 #define MIDI     TG(_MIDI)
 #define CTRL_ESC LCTL_T(KC_ESC)
 #define GAME_ESC LT(_SYS, KC_ESC)  // Gaming layer escape with system access
-#define PRINT TD(TD_PRINT)   // Tap: Print Screen | Double-tap: Shift+Print Screen
+#ifdef TAP_DANCE_ENABLE
+#    define PRINT TD(TD_PRINT) // Tap: Print Screen | Double-tap: Shift+Print Screen
+#else
+#    define PRINT KC_PSCR      // Profiles without tap dance (rules.mk)
+#endif
 
 /* ╔══════════════════════════════════════════════════════════════════════╗
  * ║  MOD-MORPH - UROB'S LINGUISTIC ?/! APPROACH                          ║
@@ -85,5 +91,7 @@ enum {
  * ╚══════════════════════════════════════════════════════════════════════╝ */
 
 // Urob's ?/! mod-morph (more linguistic than /?)
+#ifdef KEY_OVERRIDE_ENABLE
 extern const key_override_t qexcl_override;
 extern const key_override_t *key_overrides[];
+#endif
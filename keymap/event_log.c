@@ -0,0 +1,114 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * BINARY EVENT LOG
+ * Ring storage and the idle-time formatter behind the LOG_* macros in event_log.h
+ */
+
+#include "event_log.h"
+
+#if EVENT_LOG_LEVEL > LOG_LEVEL_OFF
+
+#include "print.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  RECORD RING                                                                                       ║
+ * ║  12-byte records, single producer/consumer - a full ring drops new records and counts them         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Tuning knobs (override in config.h)
+#ifndef EVENT_LOG_SIZE
+#    define EVENT_LOG_SIZE 64              // Records (power of two, at most 128)
+#endif
+#ifndef EVENT_LOG_IDLE
+#    define EVENT_LOG_IDLE 50              // ms without input before draining
+#endif
+#ifndef EVENT_LOG_DRAIN
+#    define EVENT_LOG_DRAIN 4              // Records formatted per housekeeping pass
+#endif
+
+typedef struct {
+    uint16_t time;
+    uint8_t  id;
+    int16_t  args[4];
+} event_record_t;
+
+static event_record_t event_ring[EVENT_LOG_SIZE];
+static uint8_t        event_head = 0, event_tail = 0;  // Free-running, masked on access
+static uint16_t       event_lost = 0;
+
+void event_log_write(uint8_t id, int16_t a, int16_t b, int16_t c, int16_t d) {
+    if ((uint8_t)(event_head - event_tail) >= EVENT_LOG_SIZE) {
+        event_lost++;
+        return;
+    }
+
+    event_record_t *record = &event_ring[event_head % EVENT_LOG_SIZE];
+    record->time    = timer_read();
+    record->id      = id;
+    record->args[0] = a;
+    record->args[1] = b;
+    record->args[2] = c;
+    record->args[3] = d;
+    event_head++;
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  FORMATTER                                                                                         ║
+ * ║  Runs from housekeeping only after EVENT_LOG_IDLE ms without input - never between two keys        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static const char *const event_formats[EV_COUNT] = {
+    [EV_KEY_PRESS]       = "Key r=%d c=%d -> led=%d\n",
+    [EV_KEY_RAW]         = "Raw pos=%d down=%d t=%d\n",
+    [EV_ADAPTIVE_TERM]   = "Adaptive term: key %d -> %d ms\n",
+    [EV_COMBO_TERM]      = "Combo term: %d -> %d ms\n",
+    [EV_MIDI_INIT]       = "MIDI state initialized - Oct:%d Vel:%d\n",
+    [EV_MIDI_OCTAVE]     = "MIDI octave changed to: %d\n",
+    [EV_MIDI_VELOCITY]   = "MIDI velocity set to: %d\n",
+    [EV_MIDI_NOTE]       = "MIDI Note: %d Vel: %d (Final: %d/%d)\n",
+    [EV_MIDI_INSTRUMENT] = "MIDI Instrument changed to: %d\n",
+    [EV_MIDI_CHANNEL]    = "MIDI Channel focus: %d\n",
+    [EV_MIDI_EFFECT]     = "MIDI Effect: Type %d Value %d\n",
+    [EV_MIDI_PLAY]       = "MIDI Transport: Play/Pause\n",
+    [EV_MIDI_STOP]       = "MIDI Transport: Stop\n",
+    [EV_MIDI_RECORD]     = "MIDI Record mode: %d\n",
+    [EV_MIDI_SUSTAIN]    = "MIDI Sustain: %d\n",
+    [EV_MIDI_PANIC]      = "MIDI PANIC: All notes off\n",
+    [EV_MIDI_LEARN]      = "MIDI Learn mode activated\n",
+    [EV_MIDI_CONFIG]     = "MIDI Config requested\n",
+};
+
+static void event_log_format(event_record_t *record) {
+    int16_t *args = record->args;
+
+    // Work taken out of the hot path
+    if (record->id == EV_KEY_PRESS) {
+        args[2] = NO_LED;
+        #ifdef RGB_MATRIX_ENABLE
+            if (args[0] < MATRIX_ROWS && args[1] < MATRIX_COLS) args[2] = g_led_config.matrix_co[args[0]][args[1]];
+        #endif
+    }
+
+    uprintf("%5u ", record->time);
+    if (record->id < EV_COUNT) {
+        uprintf(event_formats[record->id], args[0], args[1], args[2], args[3]);
+    } else {
+        uprintf("event %u: %d %d %d %d\n", record->id, args[0], args[1], args[2], args[3]);
+    }
+}
+
+void event_log_task(void) {
+    if (event_head == event_tail || last_input_activity_elapsed() < EVENT_LOG_IDLE) return;
+
+    if (event_lost) {
+        uprintf("Event log: %u records lost\n", event_lost);
+        event_lost = 0;
+    }
+    for (uint8_t n = 0; n < EVENT_LOG_DRAIN && event_tail != event_head; n++) {
+        event_log_format(&event_ring[event_tail % EVENT_LOG_SIZE]);
+        event_tail++;
+    }
+}
+
+#endif
@@ -0,0 +1,83 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * BINARY EVENT LOG
+ * Hot paths append fixed-size records to a RAM ring; housekeeping formats them once the keyboard is idle
+ * Shared by keymap.c and midi_enhanced.c - storage and formatting live in event_log.c
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  LEVELS                                                                                            ║
+ * ║  Compile-time - a call above EVENT_LOG_LEVEL expands to nothing, arguments are never evaluated     ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define LOG_LEVEL_OFF   0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+#ifndef EVENT_LOG_LEVEL
+#    define EVENT_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#ifndef CONSOLE_ENABLE
+#    undef EVENT_LOG_LEVEL
+#    define EVENT_LOG_LEVEL LOG_LEVEL_OFF  // Nowhere to drain to
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EVENT IDS                                                                                         ║
+ * ║  One id per message - its format string lives in event_log.c, arguments are up to four int16      ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum event_log_id {
+    EV_KEY_PRESS,        // row, col - LED looked up when formatted
+    EV_KEY_RAW,          // grid position, pressed, scan time - typing capture for replay.py
+    EV_ADAPTIVE_TERM,    // homerow key index, new term
+    EV_COMBO_TERM,       // combo index, new term
+    EV_MIDI_INIT,        // octave, velocity
+    EV_MIDI_OCTAVE,      // octave
+    EV_MIDI_VELOCITY,    // velocity
+    EV_MIDI_NOTE,        // note, velocity, final note, final velocity
+    EV_MIDI_INSTRUMENT,  // instrument
+    EV_MIDI_CHANNEL,     // channel
+    EV_MIDI_EFFECT,      // type, value
+    EV_MIDI_PLAY,
+    EV_MIDI_STOP,
+    EV_MIDI_RECORD,      // on
+    EV_MIDI_SUSTAIN,     // on
+    EV_MIDI_PANIC,
+    EV_MIDI_LEARN,
+    EV_MIDI_CONFIG,
+    EV_COUNT
+};
+
+#if EVENT_LOG_LEVEL > LOG_LEVEL_OFF
+void event_log_write(uint8_t id, int16_t a, int16_t b, int16_t c, int16_t d);
+void event_log_task(void);  // housekeeping_task_user
+#else
+static inline void event_log_task(void) {}
+#endif
+
+// Pad missing arguments with zeros: LOG_INFO(EV_MIDI_STOP), LOG_INFO(EV_MIDI_OCTAVE, octave)
+#define EVENT_LOG_ARGS_(id, a, b, c, d, ...) event_log_write((id), (a), (b), (c), (d))
+#define EVENT_LOG_(...) EVENT_LOG_ARGS_(__VA_ARGS__, 0, 0, 0, 0, 0)
+
+#if EVENT_LOG_LEVEL >= LOG_LEVEL_ERROR
+#    define LOG_ERROR(...) EVENT_LOG_(__VA_ARGS__)
+#else
+#    define LOG_ERROR(...) ((void)0)
+#endif
+#if EVENT_LOG_LEVEL >= LOG_LEVEL_INFO
+#    define LOG_INFO(...) EVENT_LOG_(__VA_ARGS__)
+#else
+#    define LOG_INFO(...) ((void)0)
+#endif
+#if EVENT_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#    define LOG_DEBUG(...) EVENT_LOG_(__VA_ARGS__)
+#else
+#    define LOG_DEBUG(...) ((void)0)
+#endif
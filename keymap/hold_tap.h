@@ -0,0 +1,304 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * UNIFIED HOLD-TAP ENGINE
+ * Table-driven tap/hold resolution for the custom dual-role keys
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  HOLD-TAP DESCRIPTORS                                                                              ║
+ * ║  One const entry per custom dual-role key - the table lives in smart_behaviors.h                   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Flavors (same meaning as ZMK's hold-tap flavors)
+enum hold_tap_flavor {
+    HT_TAP_PREFERRED,   // Hold only when the term expires
+    HT_HOLD_PREFERRED,  // Hold when the term expires or another key is pressed
+    HT_BALANCED,        // Hold when the term expires or another key is pressed AND released
+};
+
+// What the hold action does
+enum hold_tap_hold_kind {
+    HT_HOLD_KEY,    // Tap the 16-bit keycode `hold` once, the moment the hold resolves
+    HT_HOLD_LAYER,  // Momentary layer `hold` while the key is down
+    HT_HOLD_MODS,   // Mod mask `hold` registered while the key is down
+};
+
+// Streak rules and options
+#define HT_EAGER          (1 << 0)  // Apply layer/mod hold on press, roll it back if it becomes a tap
+#define HT_STREAK_REPEAT  (1 << 1)  // Re-press within STREAK_TIMEOUT → firmware auto-repeat, never a hold
+#define HT_STREAK_IDLE    (1 << 2)  // Pressed mid-word (require-prior-idle) → tap at press time
+#define HT_BUFFERED       (1 << 3)  // Hold back rolled keys until resolved, replay them on the right layer
+
+typedef struct {
+    uint16_t keycode;       // Custom keycode owning this entry
+    uint16_t tap;           // Tap keycode (ignored when on_tap is set)
+    uint16_t hold;          // Hold keycode, layer or mod mask - see hold_kind
+    uint16_t term;          // Tapping term in ms
+    uint8_t  hold_kind;     // enum hold_tap_hold_kind
+    uint8_t  flavor;        // enum hold_tap_flavor
+    uint8_t  flags;         // HT_* streak rules
+    void (*on_tap)(void);   // Custom tap action (optional)
+} hold_tap_def_t;
+
+extern const hold_tap_def_t hold_tap_defs[];
+extern const uint8_t hold_tap_def_count;
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  IN-FLIGHT SLOTS                                                                                   ║
+ * ║  Each pressed dual-role key owns a slot, so rolling two of them never shares state                 ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifndef HOLD_TAP_SLOTS
+#    define HOLD_TAP_SLOTS 4
+#endif
+
+typedef struct {
+    const hold_tap_def_t *def;  // NULL = free slot
+    deferred_token token;       // Pending term callback
+    bool resolved;              // Tap or hold has been decided
+    bool is_hold;
+    bool interrupted;           // Another key was pressed while undecided
+    bool is_streak;             // Repeat streak: tap key auto-repeated for as long as held
+    uint8_t repeats;            // Repeats sent so far (drives the acceleration curve)
+} hold_tap_slot_t;
+
+static hold_tap_slot_t hold_tap_slots[HOLD_TAP_SLOTS];
+static const hold_tap_def_t *hold_tap_last_released = NULL;
+static uint16_t hold_tap_last_release_time = 0;
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  ROLLOVER EVENT BUFFER                                                                             ║
+ * ║  Keys pressed behind an undecided HT_BUFFERED key wait here and are replayed after resolution      ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifndef HOLD_TAP_BUFFER_SIZE
+#    define HOLD_TAP_BUFFER_SIZE 8
+#endif
+
+static keyevent_t       hold_tap_buffer[HOLD_TAP_BUFFER_SIZE];
+static uint8_t          hold_tap_buffer_count = 0;
+static hold_tap_slot_t *hold_tap_buffering    = NULL;  // Slot the buffer is waiting on
+static bool             hold_tap_replaying    = false; // Buffered events are going through action_exec again
+
+// Re-run buffered events through the full pipeline - presses now resolve on the current layer
+static void hold_tap_replay_buffer(void) {
+    keyevent_t events[HOLD_TAP_BUFFER_SIZE];
+    uint8_t    count = hold_tap_buffer_count;
+
+    // Copy out first: a replayed dual-role press may start buffering again
+    memcpy(events, hold_tap_buffer, count * sizeof(keyevent_t));
+    hold_tap_buffer_count = 0;
+    hold_tap_buffering    = NULL;
+
+    // pre_process_record_user already logged these and ran them past the combo engine at scan time
+    bool was_replaying = hold_tap_replaying;
+    hold_tap_replaying = true;
+    for (uint8_t i = 0; i < count; i++) {
+        action_exec(events[i]);
+    }
+    hold_tap_replaying = was_replaying;
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  ENGINE                                                                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static void hold_tap_apply_hold(const hold_tap_def_t *def) {
+    switch (def->hold_kind) {
+        case HT_HOLD_KEY:   tap_code16(def->hold);    break;
+        case HT_HOLD_LAYER: layer_on(def->hold);      break;
+        case HT_HOLD_MODS:  register_mods(def->hold); break;
+    }
+}
+
+static void hold_tap_release_hold(const hold_tap_def_t *def) {
+    switch (def->hold_kind) {
+        case HT_HOLD_KEY:                               break;  // Already sent in full
+        case HT_HOLD_LAYER: layer_off(def->hold);       break;
+        case HT_HOLD_MODS:  unregister_mods(def->hold); break;
+    }
+}
+
+static void hold_tap_send_tap(const hold_tap_def_t *def) {
+    if (def->on_tap) {
+        def->on_tap();
+    } else {
+        tap_code16(def->tap);
+    }
+}
+
+static void hold_tap_resolve_hold(hold_tap_slot_t *slot) {
+    if (slot->token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec(slot->token);
+        slot->token = INVALID_DEFERRED_TOKEN;
+    }
+    slot->resolved = true;
+    slot->is_hold  = true;
+    if (!(slot->def->flags & HT_EAGER)) {
+        hold_tap_apply_hold(slot->def);
+    }
+    if (hold_tap_buffering == slot) {
+        hold_tap_replay_buffer();  // Rolled keys land on the hold layer
+    }
+}
+
+static uint32_t hold_tap_term_callback(uint32_t trigger_time, void *cb_arg) {
+    hold_tap_slot_t *slot = (hold_tap_slot_t *)cb_arg;
+    slot->token = INVALID_DEFERRED_TOKEN;
+
+    // Still down when the term expires: it's a hold - fire now, not on release
+    if (slot->def && !slot->resolved) {
+        hold_tap_resolve_hold(slot);
+    }
+    return 0;  // One-shot
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  STREAK AUTO-REPEAT                                                                                ║
+ * ║  Firmware-driven, accelerating repeat - identical on every host regardless of OS repeat settings   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static uint32_t hold_tap_repeat_callback(uint32_t trigger_time, void *cb_arg) {
+    hold_tap_slot_t *slot = (hold_tap_slot_t *)cb_arg;
+    if (!slot->def || !slot->is_streak) {
+        slot->token = INVALID_DEFERRED_TOKEN;
+        return 0;
+    }
+
+    tap_code16(slot->def->tap);
+
+    // Linear acceleration: every repeat shaves STREAK_REPEAT_ACCEL off the interval, down to the floor
+    uint16_t speedup  = (uint16_t)slot->repeats * STREAK_REPEAT_ACCEL;
+    uint16_t interval = STREAK_REPEAT_INTERVAL > STREAK_REPEAT_INTERVAL_MIN + speedup
+                            ? STREAK_REPEAT_INTERVAL - speedup
+                            : STREAK_REPEAT_INTERVAL_MIN;
+    if (slot->repeats < UINT8_MAX) slot->repeats++;
+    return interval;  // Reschedule
+}
+
+static const hold_tap_def_t *hold_tap_find_def(uint16_t keycode) {
+    for (uint8_t i = 0; i < hold_tap_def_count; i++) {
+        if (hold_tap_defs[i].keycode == keycode) return &hold_tap_defs[i];
+    }
+    return NULL;
+}
+
+static hold_tap_slot_t *hold_tap_find_slot(const hold_tap_def_t *def) {
+    for (uint8_t i = 0; i < HOLD_TAP_SLOTS; i++) {
+        if (hold_tap_slots[i].def == def) return &hold_tap_slots[i];
+    }
+    return NULL;
+}
+
+// Hold back keys rolled over an undecided buffered key (call from pre_process_record_user)
+bool hold_tap_buffer_event(uint16_t keycode, keyrecord_t *record) {
+    if (!hold_tap_buffering || keycode == hold_tap_buffering->def->keycode) return true;
+
+    if (!record->event.pressed) {
+        // Only hold back releases whose press is buffered too - earlier keys release normally
+        bool nested = false;
+        for (uint8_t i = 0; i < hold_tap_buffer_count; i++) {
+            if (hold_tap_buffer[i].pressed && KEYEQ(hold_tap_buffer[i].key, record->event.key)) {
+                nested = true;
+                break;
+            }
+        }
+        if (!nested) return true;
+    }
+
+    if (hold_tap_buffer_count >= HOLD_TAP_BUFFER_SIZE) {
+        // Buffer full: settle as hold, replay, then let this event through behind it
+        hold_tap_resolve_hold(hold_tap_buffering);
+        return true;
+    }
+    hold_tap_buffer[hold_tap_buffer_count++] = record->event;
+
+    // A key pressed and released inside the hold: balanced → hold
+    if (!record->event.pressed) {
+        hold_tap_resolve_hold(hold_tap_buffering);
+    }
+    return false;
+}
+
+// Feed every key event to the undecided slots (call before any other processing)
+void hold_tap_other_key(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < HOLD_TAP_SLOTS; i++) {
+        hold_tap_slot_t *slot = &hold_tap_slots[i];
+        if (!slot->def || slot->resolved || slot->def->keycode == keycode) continue;
+
+        if (record->event.pressed) {
+            slot->interrupted = true;
+            if (slot->def->flavor == HT_HOLD_PREFERRED) hold_tap_resolve_hold(slot);
+        } else if (slot->interrupted && slot->def->flavor == HT_BALANCED) {
+            hold_tap_resolve_hold(slot);
+        }
+    }
+}
+
+// Handle a key from hold_tap_defs[] - returns false when the engine consumed the event
+bool process_hold_tap(uint16_t keycode, keyrecord_t *record, bool typing_streak) {
+    const hold_tap_def_t *def = hold_tap_find_def(keycode);
+    if (!def) return true;
+
+    if (record->event.pressed) {
+        hold_tap_slot_t *slot = hold_tap_find_slot(NULL);
+        if (!slot) {
+            // All slots busy - degrade to a plain tap rather than dropping the key
+            hold_tap_send_tap(def);
+            return false;
+        }
+
+        *slot = (hold_tap_slot_t){.def = def, .token = INVALID_DEFERRED_TOKEN};
+
+        // Repeat streak: rapid re-press of the same key taps now, then auto-repeats while held
+        if ((def->flags & HT_STREAK_REPEAT) && hold_tap_last_released == def &&
+            TIMER_DIFF_16(record->event.time, hold_tap_last_release_time) < STREAK_TIMEOUT) {
+            slot->resolved  = true;
+            slot->is_streak = true;
+            tap_code16(def->tap);
+            slot->token = defer_exec(STREAK_REPEAT_DELAY, hold_tap_repeat_callback, slot);
+            return false;
+        }
+
+        // Typing streak: mid-word press resolves as a tap right away
+        if ((def->flags & HT_STREAK_IDLE) && typing_streak) {
+            slot->resolved = true;
+            hold_tap_send_tap(def);
+            return false;
+        }
+
+        if (def->flags & HT_EAGER) hold_tap_apply_hold(def);
+        if ((def->flags & HT_BUFFERED) && !hold_tap_buffering) hold_tap_buffering = slot;
+        // Term runs from the press - a replay out of the combo or hold-tap buffer arrives late
+        uint16_t elapsed = TIMER_DIFF_16(timer_read(), record->event.time);
+        slot->token      = defer_exec(elapsed < def->term ? def->term - elapsed : 1, hold_tap_term_callback, slot);
+    } else {
+        hold_tap_slot_t *slot = hold_tap_find_slot(def);
+        if (!slot) return false;  // Press was consumed by a full slot table
+
+        if (slot->token != INVALID_DEFERRED_TOKEN) {
+            cancel_deferred_exec(slot->token);
+        }
+
+        if (slot->is_streak) {
+            // Repeat timer cancelled above - every repeat was a complete tap
+        } else if (!slot->resolved) {
+            // Released before the term: roll back an eager hold, then tap
+            if (def->flags & HT_EAGER) hold_tap_release_hold(def);
+            hold_tap_send_tap(def);
+            if (hold_tap_buffering == slot) hold_tap_replay_buffer();  // Rolled keys land on the base layer
+        } else if (slot->is_hold) {
+            hold_tap_release_hold(def);
+        }
+
+        hold_tap_last_released     = def;
+        hold_tap_last_release_time = record->event.time;
+        slot->def                  = NULL;
+    }
+    return false;
+}
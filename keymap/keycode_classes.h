@@ -0,0 +1,76 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * KEYCODE CLASS TABLE
+ * One indexed load answers "is this key alpha / num-word / mouse / ...?" for smart behaviors
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  KEYCODE CLASSES                                                                                   ║
+ * ║  Bit flags per basic keycode - a key can belong to several classes                                 ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum keycode_class {
+    KCC_ALPHA     = (1 << 0),  // Letters - repeatable by MAGIC_SHIFT, capitalised by caps-word
+    KCC_NUM_WORD  = (1 << 1),  // Keeps num-word active
+    KCC_CAPS_WORD = (1 << 2),  // Non-alpha keys that keep caps-word active
+    KCC_MOUSE     = (1 << 3),  // Keeps the smart mouse layer active
+    KCC_ALT_TAB   = (1 << 4),  // Modifiers that don't close the Alt+Tab swapper
+};
+
+// Indexed by basic keycode - add a key to a class here, not in the handlers
+static const uint8_t keycode_class_table[256] PROGMEM = {
+    [KC_NO]             = KCC_NUM_WORD,                  // Layer passthroughs
+    [KC_TRNS]           = KCC_NUM_WORD,
+    [KC_A ... KC_Z]     = KCC_ALPHA,
+    [KC_1 ... KC_0]     = KCC_NUM_WORD,
+    [KC_BSPC]           = KCC_NUM_WORD | KCC_CAPS_WORD,
+    [KC_DEL]            = KCC_NUM_WORD | KCC_CAPS_WORD,
+    [KC_MINS]           = KCC_CAPS_WORD,
+    [KC_PGUP]           = KCC_MOUSE,
+    [KC_PGDN]           = KCC_MOUSE,
+    [MS_UP ... MS_RGHT] = KCC_MOUSE,
+    [MS_BTN1 ... MS_BTN8] = KCC_MOUSE,
+    [MS_WHLU ... MS_WHLR] = KCC_MOUSE,
+    [KC_LCTL]           = KCC_MOUSE | KCC_ALT_TAB,
+    [KC_LSFT]           = KCC_MOUSE | KCC_ALT_TAB,
+    [KC_LALT]           = KCC_MOUSE,
+    [KC_LGUI]           = KCC_MOUSE | KCC_ALT_TAB,
+    [KC_RCTL]           = KCC_ALT_TAB,
+    [KC_RSFT]           = KCC_ALT_TAB,
+    [KC_RGUI]           = KCC_ALT_TAB,
+};
+
+// Modded keycodes with a class of their own - a shortcut like LGUI(KC_Z) is not its base key
+static const struct {
+    uint16_t keycode;
+    uint8_t  classes;
+} keycode_class_modded[] PROGMEM = {
+    {KC_UNDS, KCC_CAPS_WORD},
+};
+
+// Basic keycode a key types: mod-taps (HRM_*, NUM_*) by their tap key
+static inline uint16_t keycode_base(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) return QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    return keycode;
+}
+
+// Classes of any keycode - 0 for layer, custom and other non-basic keycodes
+static inline uint8_t keycode_classes(uint16_t keycode) {
+    uint16_t base = keycode_base(keycode);
+    if (base <= 0xFF) return pgm_read_byte(&keycode_class_table[base]);
+    for (uint8_t i = 0; i < ARRAY_SIZE(keycode_class_modded); i++) {
+        if (pgm_read_word(&keycode_class_modded[i].keycode) == keycode) {
+            return pgm_read_byte(&keycode_class_modded[i].classes);
+        }
+    }
+    return 0;
+}
+
+static inline bool keycode_is(uint16_t keycode, uint8_t classes) {
+    return keycode_classes(keycode) & classes;
+}
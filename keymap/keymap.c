@@ -18,11 +18,24 @@
 // Include our modular components
 #include "custom_keycodes.h"
 #include "bilateral_mods.h"
+#include "adaptive_term.h"
+#include "hold_tap.h"
 #include "smart_behaviors.h"
 #include "combo_system.h"
 #include "rgb_effects.h"
 #include "layer_layouts.h"
 #include "midi_enhanced.h"
+#include "scan_profiler.h"
+#include "event_log.h"
+#include "latency_budget.h"
+#include "tournament.h"
+
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+#ifdef RAW_ENABLE
+#    include "usage_counters.h"
+#endif
 
 #ifdef MIDI_ENABLE
     #include "process_midi.h"
@@ -36,6 +49,7 @@
 
 extern keymap_config_t keymap_config;
 
+#ifdef KEY_OVERRIDE_ENABLE
 // Urob's morphs - modifier-dependent key behaviors
 // ?/! morph (more linguistic than /?)
 const key_override_t qexcl_override = ko_make_basic(MOD_MASK_SHIFT, KC_QUES, KC_EXLM);
@@ -71,6 +85,7 @@ const key_override_t *key_overrides[] = {
     &bs_del_override,
     NULL // Terminate the array
 };
+#endif
 
 /* ═══════════════════════════════════════════════════════════════════════════════════════════════════
  * TAP DANCE ACTIONS
@@ -78,9 +93,11 @@ const key_override_t *key_overrides[] = {
  * ═══════════════════════════════════════════════════════════════════════════════════════════════════ */
 
 // Tap: Print Screen | Double-tap: Shift+Print Screen
+#ifdef TAP_DANCE_ENABLE
 tap_dance_action_t tap_dance_actions[] = {
     [TD_PRINT] = ACTION_TAP_DANCE_DOUBLE(KC_PSCR, LSFT(KC_PSCR)),
 };
+#endif
 
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
@@ -116,7 +133,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     AU_ON  , AU_OFF , _______ , DEF     , _______ , RM_TOGG , _______ , _______ , RM_NEXT , RM_HUEU , RM_SATU , RM_VALU,
     MU_ON  , MU_OFF , _______ , GAMING  , _______ , QK_BOOT , QK_BOOT , _______ , RM_PREV , RM_HUED , RM_SATD , RM_VALD,
     MI_ON  , MI_OFF , _______ , MIDI    , _______ , EE_CLR  , EE_CLR  , _______ , _______ , _______ , _______ , _______,
-    AU_PREV, AU_NEXT, _______ , _______ , _______ , _______ , _______ , _______ , _______ , _______ , _______ , DB_TOGG
+    AU_PREV, AU_NEXT, _______ , _______ , _______ , _______ , _______ , _______ , _______ , LAT_STATS, CMB_STATS, DB_TOGG
 ),
 
 [_NAV] = LAYOUT_planck_grid(
@@ -155,26 +172,21 @@ float midi_layer_on[][2]  = SONG(MIDI_ON_SOUND);
 float midi_layer_off[][2] = SONG(MIDI_OFF_SOUND);
 #endif
 
-/* ═══════════════════════════════════════════════════════════════════════════════════════════════════
- * UROB-STYLE NAVIGATION HOLD-TAPS - State and Forward Declaration
- * ═══════════════════════════════════════════════════════════════════════════════════════════════════ */
-
-typedef struct {
-    uint16_t keycode;
-    uint16_t timer;
-    uint16_t last_release_timer;
-    bool is_pressed;
-    bool is_hold_activated;
-    bool other_key_pressed;
-    bool is_streak;  // Are we in rapid-tap mode?
-} nav_holdtap_state_t;
-
-static nav_holdtap_state_t nav_state = {0};
-bool process_record_user_nav_holdtap(uint16_t keycode, keyrecord_t *record);
+void keyboard_post_init_user(void) {
+    adaptive_term_load();  // Learned homerow mod terms from EEPROM
+    combo_engine_init();   // Keycode → combo candidate index
+    #ifdef SCAN_PROFILER_ENABLE
+        profiler_init();   // Start the DWT cycle counter
+    #endif
+}
 
-#define STREAK_TIMEOUT 150  // If you press again within 150ms, it's a streak
+layer_state_t default_layer_state_set_user(layer_state_t state) {
+    tournament_request(state);  // Applied from housekeeping
+    rgb_indicator_mode(RGB_IND_GAMING, get_highest_layer(state) == _GAMING);
+    return state;
+}
 
-// Keep animations dynamic: only tri-layer logic here.
+// Keep animations dynamic: tri-layer, MIDI on/off and the layer indicator only.
 layer_state_t layer_state_set_user(layer_state_t state) {
     state = update_tri_layer_state(state, _FN, _NUM, _SYS);
 
@@ -186,6 +198,7 @@ layer_state_t layer_state_set_user(layer_state_t state) {
         #ifdef MIDI_ENABLE
             midi_on();
             midi_state_init();  // Initialize enhanced MIDI state
+            rgb_indicator_mode(RGB_IND_MIDI_REC, midi_state.record_mode);  // Init stops recording
         #endif
         #ifdef AUDIO_ENABLE
             PLAY_SONG(midi_layer_on);
@@ -195,6 +208,7 @@ layer_state_t layer_state_set_user(layer_state_t state) {
         #ifdef MIDI_ENABLE
             midi_panic_all_notes_off();  // Clean exit with panic
             midi_off();
+            rgb_indicator_mode(RGB_IND_MIDI_REC, midi_state.record_mode);  // Panic stops recording
         #endif
         #ifdef AUDIO_ENABLE
             PLAY_SONG(midi_layer_off);
@@ -202,43 +216,64 @@ layer_state_t layer_state_set_user(layer_state_t state) {
     }
     midi_was_on = midi_is_on;
 
+    rgb_indicator_layers(state);
     return state;
 }
 
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    // Track if other keys are pressed while nav hold-tap is active
-    if (nav_state.is_pressed && record->event.pressed) {
-        // Another key was pressed while nav key is held
-        if (keycode != nav_state.keycode) {
-            nav_state.other_key_pressed = true;
-        }
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    PROFILE_SCOPE(PROF_RECORD);
+
+    #ifdef LATENCY_TRACE_ENABLE
+        latency_trace_open(record);  // Scan-time stamp, before anything can hold the key back
+    #endif
+
+    // Tournament mode: no combo engine, no hold-tap buffer, no logging
+    if (tournament_fast_path()) return true;
+
+    // Matrix edge at scan time, for replay.py - once, not again when the combo or hold-tap buffer replays it
+    if (!combo_replaying && !hold_tap_replaying && record->event.key.row < MATRIX_ROWS) {
+        LOG_DEBUG(EV_KEY_RAW, pgm_read_byte(&combo_position_map[record->event.key.row][record->event.key.col]),
+                  record->event.pressed, (int16_t)record->event.time);
     }
 
+    // Combos see raw presses first, like QMK's own combo hook - hold-tap replays were seen at scan time
+    if (!hold_tap_replaying && !process_combo_engine(keycode, record)) return false;
+
+    // Hold back keys rolled over an undecided SMART_SPC/SMART_NUM until it resolves
+    return hold_tap_buffer_event(keycode, record);
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    PROFILE_SCOPE(PROF_RECORD);
+
+    #ifdef LATENCY_TRACE_ENABLE
+        latency_trace_classify(keycode, record);
+    #endif
+
+    // Tournament mode: SOCD only - DEF still takes the full path to leave the mode
+    if (tournament_fast_path() && keycode != DEF) return process_socd(keycode, record, true);
+    #ifdef RAW_ENABLE
+        usage_count_record(keycode, record);  // Live counters for heatmap.py
+    #endif
+
+    // Let undecided hold-taps see every key event (interrupt-based resolution)
+    hold_tap_other_key(keycode, record);
+
+    // Learn per-key homerow mod terms from misfires
+    process_adaptive_term(keycode, record);
+
     // Handle smart behaviors first
     if (!process_smart_behaviors(keycode, record)) {
         return false;
     }
 
-    #ifdef CONSOLE_ENABLE
-        if (record->event.pressed) {
-            uint8_t r = record->event.key.row;
-            uint8_t c = record->event.key.col;
+    // Key -> LED index, looked up when the log is drained
+    if (record->event.pressed) LOG_DEBUG(EV_KEY_PRESS, record->event.key.row, record->event.key.col);
 
-        if (r < MATRIX_ROWS && c < MATRIX_COLS) {
-            uint8_t led = g_led_config.matrix_co[r][c];   // key -> LED index
-            if (led != NO_LED) {
-                uprintf("Key r=%u c=%u -> led=%u\n", r, c, led);
-            } else {
-                uprintf("Key r=%u c=%u -> led=NO_LED\n", r, c);
-            }
-        } else {
-            uprintf("Key r=%u c=%u out of range\n", r, c);
-        }
-    }
-    #endif
-
-        // Handle enhanced MIDI keycodes
+    // Handle enhanced MIDI keycodes
+    #ifdef MIDI_ENABLE
     if (keycode >= MIDI_OCT_DN2 && keycode <= MIDI_CONFIG) {
+        PROFILE_SCOPE(PROF_MIDI);
         if (!record->event.pressed) return false;  // Only process on press
         
         switch (keycode) {
@@ -298,7 +333,10 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                 return false;
                 
             // Transport controls
-            case MIDI_REC_TOGGLE: midi_transport_record_toggle(); return false;
+            case MIDI_REC_TOGGLE:
+                midi_transport_record_toggle();
+                rgb_indicator_mode(RGB_IND_MIDI_REC, midi_state.record_mode);
+                return false;
             case MIDI_PLAY_PAUSE: midi_transport_play_pause(); return false;
             case MIDI_TRANSPORT_STOP: midi_transport_stop(); return false;
             
@@ -334,21 +372,21 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                     midi_send_cc(&midi_device, midi_config.channel, 0x40, 
                                 midi_state.sustain_active ? 127 : 0);
                 #endif
-                #ifdef CONSOLE_ENABLE
-                    uprintf("MIDI Sustain: %s\n", midi_state.sustain_active ? "ON" : "OFF");
-                #endif
+                LOG_INFO(EV_MIDI_SUSTAIN, midi_state.sustain_active);
                 return false;
                 
             // Utility
-            case MIDI_PANIC: midi_panic_all_notes_off(); return false;
+            case MIDI_PANIC:
+                midi_panic_all_notes_off();
+                rgb_indicator_mode(RGB_IND_MIDI_REC, midi_state.record_mode);
+                return false;
             case MIDI_LEARN: midi_enter_learn_mode(); return false;
             case MIDI_CONFIG: 
-                #ifdef CONSOLE_ENABLE
-                    uprintf("MIDI Config requested\n");
-                #endif
+                LOG_INFO(EV_MIDI_CONFIG);
                 return false;
         }
     }
+    #endif
 
     switch (keycode) {
         case LT(0, KC_ENT):
@@ -394,101 +432,26 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
             }
             return false;
 
-        // Proper urob-style navigation hold-taps
-        case U_NAV_U:
-        case U_NAV_D:
-        case U_NAV_L:
-        case U_NAV_R:
-        case U_NAV_BS:
-        case U_NAV_DEL:
-            return process_record_user_nav_holdtap(keycode, record);
-    }
-
-    return true;
-}
-
-/* ═══════════════════════════════════════════════════════════════════════════════════════════════════
- * UROB-STYLE NAVIGATION HOLD-TAPS - Implementation
- * Proper tap/hold implementation matching Corne behavior
- * ═══════════════════════════════════════════════════════════════════════════════════════════════════ */
-
-bool process_record_user_nav_holdtap(uint16_t keycode, keyrecord_t *record) {
-    if (record->event.pressed) {
-        // Key pressed
-
-        // Check if this is a streak (rapid re-press of same key)
-        if (keycode == nav_state.keycode &&
-            timer_elapsed(nav_state.last_release_timer) < STREAK_TIMEOUT) {
-            // This is a streak! Enter repeating mode
-            nav_state.is_streak = true;
-        } else {
-            // New press or different key - reset streak
-            nav_state.is_streak = false;
-        }
-
-        nav_state.keycode = keycode;
-        nav_state.timer = timer_read();
-        nav_state.is_pressed = true;
-        nav_state.is_hold_activated = false;
-        nav_state.other_key_pressed = false;
-
-        // Only send the key immediately if we're in streak mode
-        if (nav_state.is_streak) {
-            switch (keycode) {
-                case U_NAV_U:   register_code(KC_UP);   break;
-                case U_NAV_D:   register_code(KC_DOWN); break;
-                case U_NAV_L:   register_code(KC_LEFT); break;
-                case U_NAV_R:   register_code(KC_RGHT); break;
-                case U_NAV_BS:  register_code(KC_BSPC); break;
-                case U_NAV_DEL: register_code(KC_DEL);  break;
-            }
-        }
-        // Otherwise, DON'T send anything - wait to see if it's tap or hold
-
-    } else {
-        // Key released
-        uint16_t elapsed = timer_elapsed(nav_state.timer);
-
-        // Unregister if we were in streak mode
-        if (nav_state.is_streak) {
-            switch (keycode) {
-                case U_NAV_U:   unregister_code(KC_UP);   break;
-                case U_NAV_D:   unregister_code(KC_DOWN); break;
-                case U_NAV_L:   unregister_code(KC_LEFT); break;
-                case U_NAV_R:   unregister_code(KC_RGHT); break;
-                case U_NAV_BS:  unregister_code(KC_BSPC); break;
-                case U_NAV_DEL: unregister_code(KC_DEL);  break;
-            }
-            // In streak mode, NO hold action ever triggers
-        } else {
-            // Not in streak mode
-            if (elapsed < TAPPING_TERM || nav_state.other_key_pressed) {
-                // Was a tap - send the tap action now
-                switch (keycode) {
-                    case U_NAV_U:   tap_code(KC_UP);   break;
-                    case U_NAV_D:   tap_code(KC_DOWN); break;
-                    case U_NAV_L:   tap_code(KC_LEFT); break;
-                    case U_NAV_R:   tap_code(KC_RGHT); break;
-                    case U_NAV_BS:  tap_code(KC_BSPC); break;
-                    case U_NAV_DEL: tap_code(KC_DEL);  break;
-                }
-            } else {
-                // Was a hold - send the hold action
-                switch (keycode) {
-                    case U_NAV_U:   tap_code16(C(KC_HOME)); break;  // Ctrl+Home
-                    case U_NAV_D:   tap_code16(C(KC_END));  break;  // Ctrl+End
-                    case U_NAV_L:   tap_code(KC_HOME);      break;  // Home
-                    case U_NAV_R:   tap_code(KC_END);       break;  // End
-                    case U_NAV_BS:  tap_code16(C(KC_BSPC)); break;  // Ctrl+Backspace
-                    case U_NAV_DEL: tap_code16(C(KC_DEL));  break;  // Ctrl+Delete
-                }
+        case LAT_STATS:
+            #ifdef LATENCY_TRACE_ENABLE
+            if (record->event.pressed) {
+                if (get_mods() & MOD_MASK_SHIFT) latency_trace_reset();
+                else                             latency_trace_dump();
             }
-        }
+            #endif
+            return false;
 
-        nav_state.is_pressed = false;
-        nav_state.last_release_timer = timer_read();
+        case CMB_STATS:
+            #ifdef COMBO_TELEMETRY_ENABLE
+            if (record->event.pressed) {
+                if (get_mods() & MOD_MASK_SHIFT) combo_telemetry_reset();
+                else                             combo_telemetry_dump();
+            }
+            #endif
+            return false;
     }
-    return false;
+
+    return true;
 }
 
 /* ───────────────────────── Encoder fun (optional) ─────────────────────── */
@@ -531,6 +494,25 @@ bool dip_switch_update_user(uint8_t index, bool active) {
     return true;
 }
 
+void housekeeping_task_user(void) {
+    #ifdef LATENCY_TRACE_ENABLE
+        latency_trace_task();  // Close traces whose report went out this loop
+    #endif
+    event_log_task();          // Formats logged events once typing pauses
+    tournament_task();         // Enter/leave after a default layer change
+    #ifdef SCAN_PROFILER_ENABLE
+        profiler_loop_end();   // Last - closes the loop being measured
+    #endif
+}
+
+#ifdef RAW_ENABLE
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    usage_hid_receive(data, length);
+}
+#endif
+
 void matrix_scan_user(void) {
-    // Matrix scan tasks (if needed in future)
+    #ifdef SCAN_PROFILER_ENABLE
+        profiler_matrix_scan();  // Matrix scan + debounce done
+    #endif
 }
@@ -0,0 +1,36 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * LATENCY BUDGETS
+ * Longest the keymap itself may hold a key back before it reaches the host, per processing path
+ * Checked against the configured terms at compile time - raising a term past its budget fails the build -
+ * and against measured press-to-report times by the host scenarios (tests/test_latency.cpp, make host-test)
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "adaptive_term.h"
+#include "combo_system.h"  // COMBO_TUNE_MAX with COMBO_AUTO_TUNE
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  BUDGETS                                                                                           ║
+ * ║  Combo: a key in a live combo waits for its partner, the combo output waits for the last key       ║
+ * ║  Hold: a mod/layer-tap (and any key rolled over SMART_SPC/NUM) waits for the hold decision         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Tuning knobs (override in config.h)
+#ifndef LATENCY_BUDGET_COMBO
+#    define LATENCY_BUDGET_COMBO 40        // ms - combo candidates and combo outputs
+#endif
+#ifndef LATENCY_BUDGET_HOLD
+#    define LATENCY_BUDGET_HOLD 350        // ms - hold decisions and the hold-tap buffer
+#endif
+
+_Static_assert(COMBO_TERM <= LATENCY_BUDGET_COMBO, "COMBO_TERM holds keys back longer than LATENCY_BUDGET_COMBO");
+#ifdef COMBO_AUTO_TUNE
+_Static_assert(COMBO_TUNE_MAX <= LATENCY_BUDGET_COMBO, "Auto-tune may raise combo terms past LATENCY_BUDGET_COMBO");
+#endif
+
+_Static_assert(TAPPING_TERM <= LATENCY_BUDGET_HOLD, "TAPPING_TERM delays holds longer than LATENCY_BUDGET_HOLD");
+_Static_assert(ADAPTIVE_TERM_MAX <= LATENCY_BUDGET_HOLD, "Learned homerow terms may exceed LATENCY_BUDGET_HOLD");
@@ -0,0 +1,259 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * KEY-TO-REPORT LATENCY TRACER
+ * Matrix scan timestamp → HID report change, bucketed per processing path
+ * Compiled in with LATENCY_TRACE_ENABLE
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "custom_keycodes.h"  // For key_overrides[]
+#include "hold_tap.h"
+#include "midi_enhanced.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TRACE SLOTS, SAMPLE RING, HISTOGRAMS                                                              ║
+ * ║  A press holds a slot until its report goes out, the sample lands in the ring, and housekeeping    ║
+ * ║  drains the ring into per-path histograms                                                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Tuning knobs (override in config.h)
+#ifndef LATENCY_TRACE_SLOTS
+#    define LATENCY_TRACE_SLOTS 8          // Presses in flight at the same time
+#endif
+#ifndef LATENCY_TRACE_RING
+#    define LATENCY_TRACE_RING 16          // Samples between two drains (power of two)
+#endif
+#ifndef LATENCY_TRACE_TIMEOUT
+#    define LATENCY_TRACE_TIMEOUT 1000     // No report change by then → the press produced none
+#endif
+
+#define LATENCY_BUCKETS 11                 // 0, 1, 2-3, 4-7 ... 256-511, 512+ ms
+
+enum latency_path {
+    LAT_TAP,       // Plain key, or a mod/layer-tap settled as tap
+    LAT_HOLD,      // Mod/layer-tap settled as hold, or a hold_tap.h key
+    LAT_COMBO,     // Last key of a combo → combo output
+    LAT_OVERRIDE,  // Key override (morph) replaced the key
+    LAT_MIDI,      // Ends with processing - MIDI has no HID report
+    LAT_GAMING,    // Any key with GAMING as the default layer - compare with and without TOURNAMENT_MODE
+    LAT_PATHS
+};
+
+enum latency_state {
+    LAT_FREE,
+    LAT_OPEN,      // Seen by pre_process, still held by the combo engine or the tapping buffer
+    LAT_AWAIT,     // Processed - closed by the next report change
+};
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;   // Matrix scan time, record->event.time
+    uint8_t  state;  // enum latency_state
+    uint8_t  path;   // enum latency_path
+} latency_slot_t;
+
+typedef struct {
+    uint8_t  path;
+    uint16_t latency;
+} latency_sample_t;
+
+typedef struct {
+    uint16_t buckets[LATENCY_BUCKETS];
+    uint16_t count;
+    uint16_t max;
+    uint32_t total;
+} latency_hist_t;
+
+static latency_slot_t     latency_slots[LATENCY_TRACE_SLOTS];
+static latency_sample_t   latency_ring[LATENCY_TRACE_RING];
+static uint8_t            latency_head = 0, latency_tail = 0;  // Free-running, masked on access
+static latency_hist_t     latency_hists[LAT_PATHS];
+static uint16_t           latency_lost = 0;                    // No free slot, or the ring was full
+static report_keyboard_t  latency_report;                      // Last report seen
+#ifdef NKRO_ENABLE
+static report_nkro_t      latency_nkro;                        // Last NKRO report seen - tournament mode forces it on
+#endif
+
+static const char *const latency_path_names[LAT_PATHS] = {"tap", "hold", "combo", "override", "midi", "gaming"};
+
+static latency_slot_t *latency_find(keypos_t key, uint16_t time) {
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_slot_t *slot = &latency_slots[i];
+        if (slot->state != LAT_FREE && slot->time == time && KEYEQ(slot->key, key)) return slot;
+    }
+    return NULL;
+}
+
+static void latency_close(latency_slot_t *slot, uint16_t now) {
+    if ((uint8_t)(latency_head - latency_tail) < LATENCY_TRACE_RING) {
+        latency_sample_t *sample = &latency_ring[latency_head++ % LATENCY_TRACE_RING];
+        sample->path    = slot->path;
+        sample->latency = TIMER_DIFF_16(now, slot->time);
+    } else {
+        latency_lost++;
+    }
+    slot->state = LAT_FREE;
+}
+
+// Report changed since the last call - any key or mod, in whichever report the keys go to
+static bool latency_report_changed(void) {
+#ifdef NKRO_ENABLE
+    if (keymap_config.nkro) {
+        if (!memcmp(&latency_nkro, nkro_report, sizeof(latency_nkro))) return false;
+        memcpy(&latency_nkro, nkro_report, sizeof(latency_nkro));
+        return true;
+    }
+#endif
+    if (!memcmp(&latency_report, keyboard_report, sizeof(latency_report))) return false;
+    memcpy(&latency_report, keyboard_report, sizeof(latency_report));
+    return true;
+}
+
+static inline uint8_t latency_bucket(uint16_t latency) {
+    uint8_t bucket = 0;
+    while (latency && bucket < LATENCY_BUCKETS - 1) {
+        latency >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// Same trigger test QMK's key override runs - left and right mods count the same
+static bool latency_is_override(uint16_t keycode, uint8_t mods, uint8_t layer) {
+#ifdef KEY_OVERRIDE_ENABLE
+    uint8_t active = (mods | mods >> 4) & 0x0F;
+    for (const key_override_t *const *ko = key_overrides; *ko; ko++) {
+        uint8_t trigger  = ((*ko)->trigger_mods | (*ko)->trigger_mods >> 4) & 0x0F;
+        uint8_t negative = ((*ko)->negative_mod_mask | (*ko)->negative_mod_mask >> 4) & 0x0F;
+        if ((*ko)->trigger == keycode && (trigger & ~active) == 0 && !(negative & active) &&
+            ((*ko)->layers & ((layer_state_t)1 << layer))) {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+static uint8_t latency_classify(uint16_t keycode, keyrecord_t *record) {
+    if (get_highest_layer(default_layer_state) == _GAMING) return LAT_GAMING;
+    if (IS_QK_MIDI(keycode) || (keycode >= MIDI_OCT_DN2 && keycode <= MIDI_CONFIG)) return LAT_MIDI;
+    if ((IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) && !record->tap.count) return LAT_HOLD;
+    if (hold_tap_find_def(keycode)) return LAT_HOLD;
+    if (latency_is_override(keycode, get_mods() | get_oneshot_mods(), get_highest_layer(layer_state))) return LAT_OVERRIDE;
+    return LAT_TAP;
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  HOOKS                                                                                             ║
+ * ║  open: pre_process_record_user    classify: process_record_user    combo: combo_engine.h           ║
+ * ║  task: housekeeping_task_user - closes, expires, drains                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Matrix press - replays from the combo and hold-tap buffers keep their first slot
+void latency_trace_open(keyrecord_t *record) {
+    if (!record->event.pressed || record->event.key.row >= MATRIX_ROWS) return;
+    if (latency_find(record->event.key, record->event.time)) return;
+
+    latency_slot_t *free_slot = NULL;
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_slot_t *slot = &latency_slots[i];
+        // A deferred output still missing when the next key lands never came
+        if (slot->state == LAT_AWAIT && (slot->path == LAT_HOLD || slot->path == LAT_COMBO)) slot->state = LAT_FREE;
+        if (slot->state == LAT_FREE && !free_slot) free_slot = slot;
+    }
+    if (!free_slot) {
+        latency_lost++;
+        return;
+    }
+
+    free_slot->key   = record->event.key;
+    free_slot->time  = record->event.time;
+    free_slot->state = LAT_OPEN;
+}
+
+// Press reached the keymap - its path is known now
+void latency_trace_classify(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) return;
+    latency_slot_t *slot = latency_find(record->event.key, record->event.time);
+    if (!slot || slot->state != LAT_OPEN) return;
+
+    slot->path  = latency_classify(keycode, record);
+    slot->state = LAT_AWAIT;
+}
+
+// Combo fired - latency runs from its last key, the others were the chord itself
+void latency_trace_combo(const keyevent_t *keys, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        latency_slot_t *slot = latency_find(keys[i].key, keys[i].time);
+        if (!slot) continue;
+
+        if (i + 1 < count) {
+            slot->state = LAT_FREE;
+        } else {
+            slot->path  = LAT_COMBO;
+            slot->state = LAT_AWAIT;
+        }
+    }
+}
+
+void latency_trace_task(void) {
+    uint16_t now     = timer_read();
+    bool     changed = latency_report_changed();
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_SLOTS; i++) {
+        latency_slot_t *slot = &latency_slots[i];
+        if (slot->state == LAT_FREE) continue;
+
+        if (slot->state == LAT_AWAIT) {
+            if (changed || slot->path == LAT_MIDI) {
+                latency_close(slot, now);
+                continue;
+            }
+            // Processed this loop without touching the report (layer keys, custom keys)
+            if (slot->path == LAT_TAP || slot->path == LAT_OVERRIDE || slot->path == LAT_GAMING) {
+                slot->state = LAT_FREE;
+                continue;
+            }
+        }
+        if (TIMER_DIFF_16(now, slot->time) > LATENCY_TRACE_TIMEOUT) slot->state = LAT_FREE;
+    }
+
+    while (latency_tail != latency_head) {
+        latency_sample_t *sample = &latency_ring[latency_tail++ % LATENCY_TRACE_RING];
+        latency_hist_t   *hist   = &latency_hists[sample->path];
+        if (hist->count == UINT16_MAX) continue;  // Saturated - clear to restart
+
+        hist->buckets[latency_bucket(sample->latency)]++;
+        hist->count++;
+        hist->total += sample->latency;
+        if (sample->latency > hist->max) hist->max = sample->latency;
+    }
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EXPORT                                                                                            ║
+ * ║  LAT_STATS dumps to the console (hid_listen / qmk console), Shift+LAT_STATS clears                 ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+void latency_trace_dump(void) {
+    #ifdef CONSOLE_ENABLE
+        uprintf("Key-to-report latency, ms buckets 0 1 2 4 8 16 32 64 128 256 512+ (lost %u)\n", latency_lost);
+        for (uint8_t p = 0; p < LAT_PATHS; p++) {
+            const latency_hist_t *hist = &latency_hists[p];
+            if (!hist->count) continue;
+
+            uprintf("%-8s n=%u avg=%u max=%u:", latency_path_names[p], hist->count,
+                    (uint16_t)(hist->total / hist->count), hist->max);
+            for (uint8_t b = 0; b < LATENCY_BUCKETS; b++) uprintf(" %u", hist->buckets[b]);
+            uprintf("\n");
+        }
+    #endif
+}
+
+void latency_trace_reset(void) {
+    memset(latency_hists, 0, sizeof(latency_hists));
+    latency_lost = 0;
+}
@@ -34,7 +34,7 @@
  * ╠═══════════════════════════════════════════════════════════════════════════════╣
  * ║  No combos, no homerow mods - zero input lag for competitive gaming           ║
  * ║  WASD movement cluster optimized with PlayStation face button mapping         ║
- * ║  SOCD cleaning enabled (Last Input Priority) for precise directional input    ║
+ * ║  SOCD pairs resolved per socd_pairs[] (default Last Input Priority)           ║
  * ╚═══════════════════════════════════════════════════════════════════════════════╝
  *
  * ╭───────────────────────────────────────────────────────────────────────╮
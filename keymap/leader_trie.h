@@ -0,0 +1,77 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * LEADER SEQUENCE TRIE
+ * GENERATED by leader_gen.py from leader_sequences.txt - do not edit by hand, run `make leader`
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+enum leader_action {
+    LEADER_ACT_NONE,     // Prefix only - keep reading keys
+    LEADER_ACT_UNICODE,  // Send lower/upper code point
+#ifdef UNICODE_COMMON_ENABLE
+    LEADER_ACT_MODE,     // set_unicode_input_mode(lower)
+#endif
+};
+
+// Node 0 is the root; children of a node are contiguous and sorted by key
+typedef struct {
+    uint8_t  key;          // Basic keycode that leads to this node
+    uint8_t  action;       // enum leader_action
+    uint8_t  child_count;
+    uint16_t first_child;  // Index of the first child (0 = leaf)
+    uint16_t lower;        // Code point, or unicode mode for LEADER_ACT_MODE
+    uint16_t upper;        // Shifted code point
+} leader_node_t;
+
+static const leader_node_t leader_trie[] PROGMEM = {
+    /*   0 */ {KC_NO, LEADER_ACT_NONE,    13,   1, 0x0000, 0x0000},  // root
+    /*   1 */ {KC_3,  LEADER_ACT_UNICODE,  0,   0, 0x00A3, 0x00A3},  // 3: £
+    /*   2 */ {KC_4,  LEADER_ACT_UNICODE,  0,   0, 0x20AC, 0x20AC},  // 4: €
+    /*   3 */ {KC_A,  LEADER_ACT_UNICODE,  3,  14, 0x00E4, 0x00C4},  // a: ä Ä
+    /*   4 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00E7, 0x00C7},  // c: ç Ç (cedilla)
+    /*   5 */ {KC_E,  LEADER_ACT_UNICODE,  3,  17, 0x00E9, 0x00C9},  // e: é É (acute)
+    /*   6 */ {KC_I,  LEADER_ACT_NONE,     2,  20, 0x0000, 0x0000},  // i
+    /*   7 */ {KC_L,  LEADER_ACT_NONE,     1,  22, 0x0000, 0x0000},  // l
+    /*   8 */ {KC_M,  LEADER_ACT_NONE,     1,  23, 0x0000, 0x0000},  // m
+    /*   9 */ {KC_O,  LEADER_ACT_UNICODE,  2,  24, 0x00F6, 0x00D6},  // o: ö Ö
+    /*  10 */ {KC_S,  LEADER_ACT_UNICODE,  0,   0, 0x00DF, 0x00DF},  // s: ß
+    /*  11 */ {KC_U,  LEADER_ACT_UNICODE,  3,  26, 0x00FC, 0x00DC},  // u: ü Ü
+    /*  12 */ {KC_W,  LEADER_ACT_NONE,     1,  29, 0x0000, 0x0000},  // w
+    /*  13 */ {KC_Y,  LEADER_ACT_NONE,     1,  30, 0x0000, 0x0000},  // y
+    /*  14 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00E2, 0x00C2},  // a c: â Â
+    /*  15 */ {KC_E,  LEADER_ACT_UNICODE,  0,   0, 0x00E6, 0x00C6},  // a e: æ Æ
+    /*  16 */ {KC_G,  LEADER_ACT_UNICODE,  0,   0, 0x00E0, 0x00C0},  // a g: à À
+    /*  17 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00EA, 0x00CA},  // e c: ê Ê
+    /*  18 */ {KC_D,  LEADER_ACT_UNICODE,  0,   0, 0x00EB, 0x00CB},  // e d: ë Ë
+    /*  19 */ {KC_G,  LEADER_ACT_UNICODE,  0,   0, 0x00E8, 0x00C8},  // e g: è È
+    /*  20 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00EE, 0x00CE},  // i c: î Î
+    /*  21 */ {KC_D,  LEADER_ACT_UNICODE,  0,   0, 0x00EF, 0x00CF},  // i d: ï Ï
+    /*  22 */ {KC_I,  LEADER_ACT_NONE,     1,  31, 0x0000, 0x0000},  // l i
+    /*  23 */ {KC_A,  LEADER_ACT_NONE,     1,  32, 0x0000, 0x0000},  // m a
+    /*  24 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00F4, 0x00D4},  // o c: ô Ô
+    /*  25 */ {KC_E,  LEADER_ACT_UNICODE,  0,   0, 0x0153, 0x0152},  // o e: œ Œ
+    /*  26 */ {KC_C,  LEADER_ACT_UNICODE,  0,   0, 0x00FB, 0x00DB},  // u c: û Û
+    /*  27 */ {KC_D,  LEADER_ACT_UNICODE,  0,   0, 0x00FC, 0x00DC},  // u d: ü Ü
+    /*  28 */ {KC_G,  LEADER_ACT_UNICODE,  0,   0, 0x00F9, 0x00D9},  // u g: ù Ù
+    /*  29 */ {KC_I,  LEADER_ACT_NONE,     1,  33, 0x0000, 0x0000},  // w i
+    /*  30 */ {KC_D,  LEADER_ACT_UNICODE,  0,   0, 0x00FF, 0x0178},  // y d: ÿ Ÿ
+#ifdef UNICODE_COMMON_ENABLE
+    /*  31 */ {KC_N,  LEADER_ACT_MODE,     0,   0, UNICODE_MODE_LINUX, UNICODE_MODE_LINUX},  // l i n
+#else
+    /*  31 */ {KC_N,  LEADER_ACT_NONE,     0,   0, 0x0000, 0x0000},  // l i n: no unicode in this build
+#endif
+#ifdef UNICODE_COMMON_ENABLE
+    /*  32 */ {KC_C,  LEADER_ACT_MODE,     0,   0, UNICODE_MODE_MACOS, UNICODE_MODE_MACOS},  // m a c
+#else
+    /*  32 */ {KC_C,  LEADER_ACT_NONE,     0,   0, 0x0000, 0x0000},  // m a c: no unicode in this build
+#endif
+#ifdef UNICODE_COMMON_ENABLE
+    /*  33 */ {KC_N,  LEADER_ACT_MODE,     0,   0, UNICODE_MODE_WINCOMPOSE, UNICODE_MODE_WINCOMPOSE},  // w i n
+#else
+    /*  33 */ {KC_N,  LEADER_ACT_NONE,     0,   0, 0x0000, 0x0000},  // w i n: no unicode in this build
+#endif
+};
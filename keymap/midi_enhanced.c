@@ -7,10 +7,7 @@
 #include <math.h>
 #include "midi_enhanced.h"
 #include "process_midi.h"
-
-#ifdef CONSOLE_ENABLE
-#    include "print.h"
-#endif
+#include "event_log.h"
 
 // External references to QMK MIDI system
 extern MidiDevice midi_device;
@@ -41,10 +38,7 @@ void midi_state_init(void) {
     midi_state.effect_param = 0;
     midi_state.transpose_offset = 0;
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI state initialized - Oct:%d Vel:%d\n", 
-                midi_state.current_octave, midi_state.velocity_level);
-    #endif
+    LOG_INFO(EV_MIDI_INIT, midi_state.current_octave, midi_state.velocity_level);
 }
 
 void midi_state_reset(void) {
@@ -68,9 +62,7 @@ void midi_update_octave(int8_t delta) {
     if (new_octave >= MIDI_OCT_MIN && new_octave <= MIDI_OCT_MAX) {
         midi_state.current_octave = new_octave;
         
-        #ifdef CONSOLE_ENABLE
-            uprintf("MIDI octave changed to: %d\n", midi_state.current_octave);
-        #endif
+        LOG_INFO(EV_MIDI_OCTAVE, midi_state.current_octave);
         
         #ifdef AUDIO_ENABLE
             midi_play_feedback_tone(60 + (midi_state.current_octave * 12));
@@ -86,18 +78,14 @@ void midi_update_velocity(int8_t delta) {
     
     midi_state.velocity_level = (uint8_t)new_velocity;
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI velocity changed to: %d\n", midi_state.velocity_level);
-    #endif
+    LOG_INFO(EV_MIDI_VELOCITY, midi_state.velocity_level);
 }
 
 void midi_set_velocity_level(uint8_t level) {
     if (level >= 1 && level <= 127) {
         midi_state.velocity_level = level;
         
-        #ifdef CONSOLE_ENABLE
-            uprintf("MIDI velocity set to: %d\n", midi_state.velocity_level);
-        #endif
+        LOG_INFO(EV_MIDI_VELOCITY, midi_state.velocity_level);
     }
 }
 
@@ -119,10 +107,7 @@ void midi_send_note_to_furnace(uint8_t note, uint8_t velocity) {
         }
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Note: %d Vel: %d (Final: %d/%d)\n", 
-                note, velocity, final_note, final_velocity);
-    #endif
+    LOG_DEBUG(EV_MIDI_NOTE, note, velocity, final_note, final_velocity);
 }
 
 void midi_send_instrument_change(uint8_t instrument) {
@@ -133,9 +118,7 @@ void midi_send_instrument_change(uint8_t instrument) {
         midi_send_programchange(&midi_device, midi_config.channel, instrument);
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Instrument changed to: %d\n", instrument);
-    #endif
+    LOG_INFO(EV_MIDI_INSTRUMENT, instrument);
 }
 
 void midi_send_channel_focus(uint8_t channel) {
@@ -147,9 +130,7 @@ void midi_send_channel_focus(uint8_t channel) {
             midi_send_cc(&midi_device, midi_config.channel, 0x78, channel);
         #endif
         
-        #ifdef CONSOLE_ENABLE
-            uprintf("MIDI Channel focus: %d\n", channel);
-        #endif
+        LOG_INFO(EV_MIDI_CHANNEL, channel);
     }
 }
 
@@ -161,9 +142,7 @@ void midi_send_effect(uint8_t effect_type, uint8_t value) {
         midi_send_cc(&midi_device, midi_config.channel, 0x10 + effect_type, value);
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Effect: Type %d Value %d\n", effect_type, value);
-    #endif
+    LOG_INFO(EV_MIDI_EFFECT, effect_type, value);
 }
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -218,9 +197,7 @@ void midi_transport_play_pause(void) {
         midi_send_cc(&midi_device, midi_config.channel, 0x7A, 127);
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Transport: Play/Pause\n");
-    #endif
+    LOG_INFO(EV_MIDI_PLAY);
 }
 
 void midi_transport_stop(void) {
@@ -229,9 +206,7 @@ void midi_transport_stop(void) {
         midi_send_cc(&midi_device, midi_config.channel, 0x7B, 0);  // All notes off
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Transport: Stop\n");
-    #endif
+    LOG_INFO(EV_MIDI_STOP);
 }
 
 void midi_transport_record_toggle(void) {
@@ -242,9 +217,7 @@ void midi_transport_record_toggle(void) {
         midi_send_cc(&midi_device, midi_config.channel, 0x7F, midi_state.record_mode ? 127 : 0);
     #endif
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Record mode: %s\n", midi_state.record_mode ? "ON" : "OFF");
-    #endif
+    LOG_INFO(EV_MIDI_RECORD, midi_state.record_mode);
 }
 
 /* ═══════════════════════════════════════════════════════════════════════════
@@ -262,16 +235,12 @@ void midi_panic_all_notes_off(void) {
     
     midi_state_reset();
     
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI PANIC: All notes off\n");
-    #endif
+    LOG_ERROR(EV_MIDI_PANIC);
 }
 
 void midi_enter_learn_mode(void) {
     // Placeholder for MIDI learn functionality
-    #ifdef CONSOLE_ENABLE
-        uprintf("MIDI Learn mode activated\n");
-    #endif
+    LOG_INFO(EV_MIDI_LEARN);
     
     #ifdef AUDIO_ENABLE
         midi_play_mode_change_sound();
@@ -8,6 +8,8 @@
 #pragma once
 
 #include QMK_KEYBOARD_H
+#include "custom_keycodes.h"
+#include "scan_profiler.h"
 
 /* ----- Safe RGB fallbacks so it still compiles without RGB Matrix ----- */
 #if !defined(RGB_MATRIX_ENABLE)
@@ -21,6 +23,16 @@
 #    define RM_VALD KC_NO
 #endif
 
+// Indicated modes (rgb_mode_palette[] order)
+enum rgb_indicator_mode {
+    RGB_IND_GAMING,     // GAMING is the default layer - dark in TOURNAMENT_MODE, which turns RGB off
+    RGB_IND_NUM_WORD,
+    RGB_IND_CAPS_WORD,
+    RGB_IND_MIDI_REC,   // Furnace pattern recording
+    RGB_IND_LEADER,     // Leader sequence pending
+    RGB_IND_MODES
+};
+
 #ifdef RGB_MATRIX_ENABLE
 
 /* ╔═══════════════════════════════════════════════════════════════════════════════════════════════════╗
@@ -29,12 +41,13 @@
  * ╚═══════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
 // LED groups (left→right)
-const uint8_t LED_TOP[]    = {6, 5, 4, 3};
-const uint8_t LED_MID[]    = {0};
-const uint8_t LED_BOTTOM[] = {7, 8, 1, 2};
-const uint8_t LED_ALL[]    = {0, 1, 2, 3, 4, 5, 6, 7, 8};
-const uint8_t LED_LEFT[]   = {6, 7};
-const uint8_t LED_RIGHT[]  = {3, 2};
+const uint8_t LED_TOP[]     = {6, 5, 4, 3};
+const uint8_t LED_MID[]     = {0};
+const uint8_t LED_BOTTOM[]  = {7, 8, 1, 2};
+const uint8_t LED_ALL[]     = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+const uint8_t LED_LEFT[]    = {6, 7};
+const uint8_t LED_RIGHT[]   = {3, 2};
+const uint8_t LED_CORNERS[] = {6, 7, 3, 2};
 
 /* ╔═══════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  RGB UTILITY FUNCTIONS                                                                            ║
@@ -55,32 +68,92 @@ static inline void set_group_hsv(const uint8_t *grp, uint8_t cnt, uint8_t h, uin
 }
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
- * ║  LAYER INDICATOR SYSTEM                                                                            ║
- * ║  Visual feedback for active layers and modes                                                       ║
+ * ║  LAYER AND MODE INDICATORS                                                                         ║
+ * ║  Layer and mode hooks mark the frame dirty - only then is it rebuilt from the palettes, every      ║
+ * ║  other frame just repaints the precomputed LEDs over the running effect                            ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
-bool rgb_matrix_indicators_user(void) {
-    // Gaming layer visual feedback - subtle red corner indicators only
-    if (get_highest_layer(default_layer_state) == _GAMING) {
-        // Red indicators in corners only, allowing RGB effects to continue
-        set_group_color(LED_LEFT, ARRAY_SIZE(LED_LEFT), 255, 0, 0);   // Left corners
-        set_group_color(LED_RIGHT, ARRAY_SIZE(LED_RIGHT), 255, 0, 0); // Right corners
-        return false; // allow RGB effects to continue
+
+typedef struct {
+    const uint8_t *leds;   // LED group, NULL = no indicator
+    uint8_t        count;
+    uint8_t        r, g, b;
+} rgb_indicator_t;
+
+#define RGB_IND(group, r, g, b) {group, ARRAY_SIZE(group), r, g, b}
+
+// Highest momentary layer → center LED (GAMING is only ever a default layer: RGB_IND_GAMING)
+static const rgb_indicator_t rgb_layer_palette[] = {
+    [_DEF]    = {NULL},
+    [_NUM]    = RGB_IND(LED_MID, 0, 80, 255),    // Blue
+    [_FN]     = RGB_IND(LED_MID, 0, 255, 0),     // Green
+    [_SYS]    = RGB_IND(LED_MID, 255, 0, 255),   // Magenta
+    [_NAV]    = RGB_IND(LED_MID, 0, 255, 255),   // Cyan
+    [_MOUSE]  = RGB_IND(LED_MID, 255, 128, 0),   // Orange
+    [_MIDI]   = RGB_IND(LED_MID, 128, 0, 255),   // Purple
+};
+
+// Modes, painted in order over the layer - later entries win a shared LED
+static const rgb_indicator_t rgb_mode_palette[RGB_IND_MODES] = {
+    [RGB_IND_GAMING]    = RGB_IND(LED_CORNERS, 255, 0, 0),    // Red corners
+    [RGB_IND_NUM_WORD]  = RGB_IND(LED_BOTTOM, 0, 80, 255),    // Blue bottom row
+    [RGB_IND_CAPS_WORD] = RGB_IND(LED_TOP, 255, 255, 255),    // White top row
+    [RGB_IND_MIDI_REC]  = RGB_IND(LED_LEFT, 255, 0, 0),       // Red left pair
+    [RGB_IND_LEADER]    = RGB_IND(LED_MID, 255, 200, 0),      // Amber center
+};
+
+_Static_assert(RGB_MATRIX_LED_COUNT <= 16, "rgb_frame_mask holds one bit per LED");
+
+static bool     rgb_frame_dirty     = true;
+static uint8_t  rgb_indicator_layer = 0;  // Highest momentary layer
+static uint8_t  rgb_indicator_modes = 0;  // Bit per enum rgb_indicator_mode
+static uint16_t rgb_frame_mask      = 0;  // LEDs the indicators own
+static RGB      rgb_frame[RGB_MATRIX_LED_COUNT];
+
+static void rgb_frame_paint(const rgb_indicator_t *ind) {
+    for (uint8_t i = 0; i < ind->count; i++) {
+        rgb_frame[ind->leds[i]] = (RGB){ind->r, ind->g, ind->b};
+        rgb_frame_mask |= 1 << ind->leds[i];
+    }
+}
+
+static void rgb_frame_build(void) {
+    rgb_frame_mask = 0;
+    if (rgb_indicator_layer < ARRAY_SIZE(rgb_layer_palette)) rgb_frame_paint(&rgb_layer_palette[rgb_indicator_layer]);
+    for (uint8_t mode = 0; mode < RGB_IND_MODES; mode++) {
+        if (rgb_indicator_modes & (1 << mode)) rgb_frame_paint(&rgb_mode_palette[mode]);
     }
+    rgb_frame_dirty = false;
+}
+
+// Call from layer_state_set_user
+void rgb_indicator_layers(layer_state_t state) {
+    uint8_t layer = get_highest_layer(state);
+    if (layer == rgb_indicator_layer) return;
+    rgb_indicator_layer = layer;
+    rgb_frame_dirty     = true;
+}
 
-    // Layer-specific lighting disabled as requested
-    // RGB matrix effects (RM_NEXT, etc.) still work
-    return false; // keep animations
+// Call where a mode starts or ends
+void rgb_indicator_mode(uint8_t mode, bool on) {
+    uint8_t modes = on ? rgb_indicator_modes | (1 << mode) : rgb_indicator_modes & ~(1 << mode);
+    if (modes == rgb_indicator_modes) return;
+    rgb_indicator_modes = modes;
+    rgb_frame_dirty     = true;
+}
+
+bool rgb_matrix_indicators_user(void) {
+    PROFILE_SCOPE(PROF_RGB);
+
+    if (rgb_frame_dirty) rgb_frame_build();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT && (rgb_frame_mask >> led); led++) {
+        if (rgb_frame_mask & (1 << led)) rgb_matrix_set_color(led, rgb_frame[led].r, rgb_frame[led].g, rgb_frame[led].b);
+    }
+    return false;  // Effects keep running underneath
 }
 
-// Built-in RGB matrix effects are enabled and will be accessible via RM_NEXT
-// Custom effects removed due to QMK compilation complexity
+#else
 
-// Layer-specific lighting functions (placeholders for future use)
-void indicate_gaming_layer(void);
-void indicate_num_layer(void);
-void indicate_function_layer(void);
-void indicate_nav_layer(void);
-void indicate_system_layer(void);
-void indicate_midi_layer(void);
+static inline void rgb_indicator_layers(layer_state_t state) {}
+static inline void rgb_indicator_mode(uint8_t mode, bool on) {}
 
 #endif // RGB_MATRIX_ENABLE
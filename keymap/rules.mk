@@ -9,8 +9,50 @@ OS_DETECTION_ENABLE = yes
 RGB_MATRIX_ENABLE = yes
 RGBLIGHT_ENABLE = no
 CONSOLE_ENABLE = yes
-COMBO_ENABLE = yes
+RAW_ENABLE = yes         # Usage counters for heatmap.py (usage_counters.h)
+COMBO_ENABLE = no        # Replaced by the indexed engine in combo_engine.h
 KEY_OVERRIDE_ENABLE = yes
+NKRO_ENABLE = yes        # Forced on by tournament mode (tournament.h), 6KRO otherwise
+
+# Binary event log drained from housekeeping (event_log.h)
+SRC += event_log.c
+
+# Build profiles (make typing | gaming | music | full) - each strips what its mode doesn't use
+# Features off here are compiled out of the keymap too; LEAN_RGB keeps only static RGB effects
+PROFILE ?= full
+
+ifeq ($(PROFILE),typing)
+    AUDIO_ENABLE = no
+    MIDI_ENABLE = no
+    CONSOLE_ENABLE = no
+    OPT_DEFS += -DLEAN_RGB
+endif
+ifeq ($(PROFILE),gaming)
+    AUDIO_ENABLE = no
+    MIDI_ENABLE = no
+    CONSOLE_ENABLE = no
+    RAW_ENABLE = no
+    UNICODE_ENABLE = no
+    TAP_DANCE_ENABLE = no
+    KEY_OVERRIDE_ENABLE = no
+    DEBOUNCE_TYPE = asym_eager_defer_pk  # Press reported on the first edge - debounce is link-time only
+    OPT_DEFS += -DLEAN_RGB
+endif
+ifeq ($(PROFILE),music)
+    CONSOLE_ENABLE = no
+    RAW_ENABLE = no
+    UNICODE_ENABLE = no
+    KEY_OVERRIDE_ENABLE = no
+    OPT_DEFS += -DLEAN_RGB
+endif
+
+# Scan-loop profiler on top of any profile (make typing SCAN=yes) - prints measured loop times
+ifeq ($(PROFILE_SCAN),yes)
+    CONSOLE_ENABLE = yes
+    OPT_DEFS += -DSCAN_PROFILER_ENABLE
+endif
 
 # Include MIDI enhanced functionality
-SRC += midi_enhanced.c
+ifeq ($(strip $(MIDI_ENABLE)), yes)
+    SRC += midi_enhanced.c
+endif
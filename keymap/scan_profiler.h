@@ -0,0 +1,259 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * SCAN-LOOP PROFILER
+ * Loop time min/avg/max split by subsystem, overrun log with the section to blame
+ * Compiled in with SCAN_PROFILER_ENABLE - PROFILE_SCOPE() is empty otherwise
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  SECTIONS                                                                                          ║
+ * ║  Time is exclusive: a section nested in another (MIDI inside process_record) pauses its parent     ║
+ * ║  Core = the rest of the loop - QMK's own record handling, RGB effect render, USB, interrupts       ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum profile_section {
+    PROF_MATRIX,   // Loop start → matrix_scan_user (scan + debounce)
+    PROF_RECORD,   // process_record_user and the hold-tap buffer
+    PROF_COMBO,    // Combo engine
+    PROF_RGB,      // RGB indicators
+    PROF_MIDI,     // Enhanced MIDI keycodes
+    PROF_EEPROM,   // EEPROM writes
+    PROF_CORE,     // Everything not in a section
+    PROF_SECTIONS
+};
+
+#ifdef SCAN_PROFILER_ENABLE
+
+// Tuning knobs (override in config.h)
+#ifndef PROFILER_BUDGET_US
+#    define PROFILER_BUDGET_US 1000        // Loops slower than this are logged
+#endif
+#ifndef PROFILER_REPORT_INTERVAL
+#    define PROFILER_REPORT_INTERVAL 10000 // ms between summaries
+#endif
+#ifndef PROFILER_LOG_BURST
+#    define PROFILER_LOG_BURST 8           // Overrun lines per summary window, the rest are counted
+#endif
+#define PROFILER_DEPTH 4
+
+// Cycle counter: DWT on Cortex-M3/M4 (Planck rev7 STM32F411), the ms timer anywhere else
+#if defined(PROTOCOL_CHIBIOS) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+#    include <hal.h>
+#    ifndef PROFILER_CYCLES_PER_US
+#        ifdef STM32_SYSCLK
+#            define PROFILER_CYCLES_PER_US (STM32_SYSCLK / 1000000)
+#        else
+#            define PROFILER_CYCLES_PER_US 96
+#        endif
+#    endif
+static inline uint32_t profiler_now(void) {
+    return DWT->CYCCNT;
+}
+static inline void profiler_clock_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#else
+#    define PROFILER_CYCLES_PER_US 1
+static inline uint32_t profiler_now(void) {
+    return timer_read32() * 1000;  // ms resolution - the split is only meaningful with DWT
+}
+static inline void profiler_clock_init(void) {}
+#endif
+
+#define PROFILER_US(cycles) ((uint32_t)((cycles) / PROFILER_CYCLES_PER_US))
+#define PROFILER_NS(cycles) ((uint32_t)((cycles) * 1000 / PROFILER_CYCLES_PER_US))
+
+typedef struct {
+    uint64_t total;  // Cycles this window
+    uint32_t max;    // Worst single loop
+} profiler_stat_t;
+
+static const char *const profiler_names[PROF_SECTIONS] = {"matrix", "record", "combo", "rgb", "midi", "eeprom", "core"};
+
+static uint32_t        profiler_loop[PROF_SECTIONS];  // Cycles per section in the current loop
+static profiler_stat_t profiler_stats[PROF_SECTIONS];
+static uint8_t         profiler_stack[PROFILER_DEPTH];
+static uint8_t         profiler_depth       = 0;
+static uint32_t        profiler_mark        = 0;           // Last charge point
+static uint32_t        profiler_loop_start  = 0;
+static uint32_t        profiler_loops       = 0;
+static uint64_t        profiler_loop_total  = 0;
+static uint32_t        profiler_loop_min    = UINT32_MAX;
+static uint32_t        profiler_loop_max    = 0;
+static uint16_t        profiler_overruns    = 0;
+static uint32_t        profiler_report_time = 0;
+static bool            profiler_skip        = true;        // Don't measure a loop that printed
+
+// Bill the time since the last mark to the innermost open section (deeper nesting bills its parent)
+static inline void profiler_charge(uint32_t now) {
+    uint8_t top = profiler_depth < PROFILER_DEPTH ? profiler_depth : PROFILER_DEPTH;
+    if (top) profiler_loop[profiler_stack[top - 1]] += now - profiler_mark;
+    profiler_mark = now;
+}
+
+static inline uint8_t profiler_enter(uint8_t section) {
+    profiler_charge(profiler_now());
+    if (profiler_depth < PROFILER_DEPTH) profiler_stack[profiler_depth] = section;
+    profiler_depth++;
+    return section;
+}
+
+static inline void profiler_scope_exit(uint8_t *section) {
+    profiler_charge(profiler_now());
+    if (profiler_depth) profiler_depth--;
+}
+
+// Section runs to the end of the enclosing block, early returns included
+#define PROFILE_SCOPE(section) \
+    __attribute__((cleanup(profiler_scope_exit), unused)) uint8_t profile_scope_ = profiler_enter(section)
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EVENT COST                                                                                        ║
+ * ║  Cycles per process_smart_behaviors call, by the kind of event it handled                          ║
+ * ║  Instruction counts come from the host benchmark (tests/bench_events.c) - not measured on device   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum profile_event {
+    PEV_ALPHA,     // Letter on a typing layer
+    PEV_HOLD_TAP,  // SMART_SPC, SMART_NUM, MAGIC_SHIFT, NAV keys
+    PEV_LEADER,    // Any key while a leader sequence is open
+    PEV_GAMING,    // Any key with GAMING as the default layer (SOCD) - bypassed in tournament mode
+    PEV_OTHER,
+    PEV_KINDS
+};
+
+typedef struct {
+    uint32_t calls;
+    uint64_t cycles;
+    uint32_t max;    // Slowest call, cycles
+} profiler_event_t;
+
+typedef struct {
+    uint8_t  kind;
+    uint32_t start;
+} profiler_event_mark_t;
+
+static const char *const profiler_event_names[PEV_KINDS] = {"alpha", "hold_tap", "leader", "gaming", "other"};
+
+static profiler_event_t profiler_events[PEV_KINDS];
+
+static inline profiler_event_mark_t profiler_event_begin(uint8_t kind) {
+    return (profiler_event_mark_t){.kind = kind, .start = profiler_now()};
+}
+
+static inline void profiler_event_end(profiler_event_mark_t *mark) {
+    uint32_t          cycles = profiler_now() - mark->start;
+    profiler_event_t *event  = &profiler_events[mark->kind];
+    event->calls++;
+    event->cycles += cycles;
+    if (cycles > event->max) event->max = cycles;
+}
+
+// Call runs to the end of the enclosing block - one per handler
+#define PROFILE_EVENT(kind) \
+    __attribute__((cleanup(profiler_event_end), unused)) profiler_event_mark_t profile_event_ = profiler_event_begin(kind)
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  LOOP HOOKS                                                                                        ║
+ * ║  matrix_scan_user closes the matrix section, housekeeping_task_user closes the loop                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+void profiler_init(void) {
+    profiler_clock_init();
+    profiler_loop_start  = profiler_now();
+    profiler_report_time = timer_read32();
+}
+
+void profiler_matrix_scan(void) {
+    uint32_t now = profiler_now();
+    profiler_loop[PROF_MATRIX] = now - profiler_loop_start;
+    profiler_mark              = now;
+}
+
+static void profiler_report(void) {
+    #ifdef CONSOLE_ENABLE
+        if (profiler_loops) {
+            uprintf("Scan loop: %lu loops, min %lu avg %lu max %lu us, %u over %u us\n", profiler_loops,
+                    PROFILER_US(profiler_loop_min), PROFILER_US(profiler_loop_total / profiler_loops),
+                    PROFILER_US(profiler_loop_max), profiler_overruns, PROFILER_BUDGET_US);
+            for (uint8_t s = 0; s < PROF_SECTIONS; s++) {
+                uprintf("  %-7s avg %lu max %lu us\n", profiler_names[s],
+                        PROFILER_US(profiler_stats[s].total / profiler_loops), PROFILER_US(profiler_stats[s].max));
+            }
+        }
+        // One JSON object per line - `grep '^{'` a console capture to keep a baseline
+        for (uint8_t e = 0; e < PEV_KINDS; e++) {
+            const profiler_event_t *event = &profiler_events[e];
+            if (!event->calls) continue;
+            uprintf("{\"event\":\"%s\",\"calls\":%lu,\"cycles_avg\":%lu,\"ns_avg\":%lu,\"ns_max\":%lu}\n",
+                    profiler_event_names[e], event->calls, (uint32_t)(event->cycles / event->calls),
+                    PROFILER_NS(event->cycles / event->calls), PROFILER_NS(event->max));
+        }
+    #endif
+    memset(profiler_stats, 0, sizeof(profiler_stats));
+    memset(profiler_events, 0, sizeof(profiler_events));
+    profiler_loops      = 0;
+    profiler_loop_total = 0;
+    profiler_loop_min   = UINT32_MAX;
+    profiler_loop_max   = 0;
+    profiler_overruns   = 0;
+}
+
+// Last call in housekeeping_task_user
+void profiler_loop_end(void) {
+    uint32_t now   = profiler_now();
+    uint32_t total = now - profiler_loop_start;
+    bool     print = false;
+
+    if (!profiler_skip) {
+        uint32_t sections = 0;
+        for (uint8_t s = 0; s < PROF_CORE; s++) sections += profiler_loop[s];
+        profiler_loop[PROF_CORE] = total > sections ? total - sections : 0;
+
+        uint8_t worst = PROF_MATRIX;
+        for (uint8_t s = 0; s < PROF_SECTIONS; s++) {
+            profiler_stats[s].total += profiler_loop[s];
+            if (profiler_loop[s] > profiler_stats[s].max) profiler_stats[s].max = profiler_loop[s];
+            if (profiler_loop[s] > profiler_loop[worst]) worst = s;
+        }
+
+        profiler_loops++;
+        profiler_loop_total += total;
+        if (total < profiler_loop_min) profiler_loop_min = total;
+        if (total > profiler_loop_max) profiler_loop_max = total;
+
+        if (PROFILER_US(total) > PROFILER_BUDGET_US) {
+            #ifdef CONSOLE_ENABLE
+                if (profiler_overruns < PROFILER_LOG_BURST) {
+                    uprintf("Overrun: %lu us, %s %lu us\n", PROFILER_US(total), profiler_names[worst],
+                            PROFILER_US(profiler_loop[worst]));
+                    print = true;
+                }
+            #endif
+            profiler_overruns++;
+        }
+    }
+
+    if (timer_elapsed32(profiler_report_time) >= PROFILER_REPORT_INTERVAL) {
+        profiler_report();
+        profiler_report_time = timer_read32();
+        print                = true;
+    }
+
+    memset(profiler_loop, 0, sizeof(profiler_loop));
+    profiler_skip       = print;  // Console output is flushed during the next loop
+    profiler_loop_start = profiler_now();
+    profiler_mark       = profiler_loop_start;
+}
+
+#else
+#    define PROFILE_SCOPE(section)
+#    define PROFILE_EVENT(kind)
+#endif
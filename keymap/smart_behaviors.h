@@ -9,6 +9,15 @@
 
 #include QMK_KEYBOARD_H
 #include "bilateral_mods.h"
+#include "hold_tap.h"
+#include "keycode_classes.h"
+#include "leader_trie.h"
+#include "rgb_effects.h"
+#include "scan_profiler.h"
+#include "socd.h"
+#ifdef RAW_ENABLE
+#    include "usage_counters.h"
+#endif
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  SMART BEHAVIOR STATE VARIABLES                                                                    ║
@@ -17,29 +26,19 @@
 
 // Smart behavior state variables
 bool num_word_active = false;
-uint16_t magic_shift_timer = 0;
 uint16_t last_keycode = KC_NO;
 bool last_key_was_alpha = false;
+uint16_t last_alpha_press_time = 0;  // Press time of the last alpha key (require-prior-idle)
 uint16_t magic_shift_tap_timer = 0;
 bool caps_word_active = false;
-uint16_t smart_num_tap_timer = 0;
 bool leader_active = false;
-uint16_t leader_timer = 0;
-uint16_t leader_sequence[3] = {KC_NO, KC_NO, KC_NO};  // Track up to 3 keys for OS switching
-uint8_t leader_sequence_count = 0;
+uint16_t leader_node = 0;      // Current leader_trie[] node (0 = root)
+bool leader_shift = false;     // Shift state captured with the pending prefix match
+deferred_token leader_timeout_token = INVALID_DEFERRED_TOKEN;
 bool smart_mouse_active = false;
 uint16_t smart_mouse_tap_timer = 0;
-uint16_t smart_spc_timer = 0;
 bool alt_tab_active = false;
 
-// SOCD cleaning variables for gaming layer
-bool socd_w_pressed = false;
-bool socd_s_pressed = false;
-bool socd_a_pressed = false;
-bool socd_d_pressed = false;
-uint16_t socd_last_horizontal = KC_NO;  // Last pressed: A or D
-uint16_t socd_last_vertical = KC_NO;    // Last pressed: W or S
-
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  SMART NUM-WORD BEHAVIOR (UROB'S AUTO-LAYER)                                                      ║
  * ║  Automatically deactivates NUM layer when pressing non-number keys                                 ║
@@ -52,26 +51,28 @@ static void handle_num_word_logic(uint16_t keycode, keyrecord_t *record) {
         return;
     }
 
-    // Check if the keycode should keep Numword active
-    // Numword stays active for: numbers (0-9), homerow mod numbers, BSPC, DEL
-    bool is_numword_key = (keycode >= KC_1 && keycode <= KC_0) ||  // Number keys on base layer
-                          (keycode >= KC_7 && keycode <= KC_9) ||   // 7, 8, 9 on NUM layer
-                          (keycode == NUM_0) ||                      // Homerow mod 0 (Cmd/0)
-                          (keycode == NUM_4) ||                      // Homerow mod 4 (Alt/4)
-                          (keycode == NUM_5) ||                      // Homerow mod 5 (Shift/5)
-                          (keycode == NUM_6) ||                      // Homerow mod 6 (Ctrl/6)
-                          (keycode == KC_BSPC) ||                    // Backspace
-                          (keycode == KC_DEL) ||                     // Delete
-                          (keycode == SMART_NUM) ||                  // The trigger key itself
-                          (keycode == KC_NO) || (keycode == KC_TRNS);  // Layer passthroughs
+    // Numword stays active for: numbers (0-9, incl. homerow mod numbers), BSPC, DEL, layer passthroughs
+    bool is_numword_key = keycode_is(keycode, KCC_NUM_WORD) ||
+                          (keycode == SMART_NUM);  // The trigger key itself
 
     // If non-numword key pressed, deactivate Numword
     if (!is_numword_key) {
         num_word_active = false;
+        rgb_indicator_mode(RGB_IND_NUM_WORD, false);
         layer_off(_NUM);
     }
 }
 
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TYPING STREAK DETECTION (UROB'S REQUIRE-PRIOR-IDLE-MS)                                            ║
+ * ║  Custom dual-role keys pressed mid-word resolve as a tap at press time                             ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static inline bool in_typing_streak(keyrecord_t *record) {
+    return last_key_was_alpha &&
+           TIMER_DIFF_16(record->event.time, last_alpha_press_time) < FLOW_TAP_TERM;
+}
+
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  KEYCODE TRACKING AND CAPS-WORD LOGIC                                                              ║
  * ║  Smart context awareness for intelligent behaviors                                                 ║
@@ -80,24 +81,15 @@ static void handle_num_word_logic(uint16_t keycode, keyrecord_t *record) {
 static void handle_keycode_tracking(uint16_t keycode, keyrecord_t *record) {
     // Track last keycode for MAGIC_SHIFT repeat behavior
     if (record->event.pressed && keycode != MAGIC_SHIFT) {
-        // Check if it's an alpha key (A-Z or homerow mods)
-        bool is_alpha = (keycode >= KC_A && keycode <= KC_Z) ||
-                       (keycode == HRM_A) || (keycode == HRM_R) || (keycode == HRM_S) || (keycode == HRM_T) ||
-                       (keycode == HRM_N) || (keycode == HRM_E) || (keycode == HRM_I) || (keycode == HRM_O);
+        uint8_t classes = keycode_classes(keycode);
+        bool is_alpha = classes & KCC_ALPHA;  // A-Z or homerow mods
 
         if (is_alpha) {
             // For homerow mods, store the base keycode for repeat
-            if (keycode == HRM_A) last_keycode = KC_A;
-            else if (keycode == HRM_R) last_keycode = KC_R;
-            else if (keycode == HRM_S) last_keycode = KC_S;
-            else if (keycode == HRM_T) last_keycode = KC_T;
-            else if (keycode == HRM_N) last_keycode = KC_N;
-            else if (keycode == HRM_E) last_keycode = KC_E;
-            else if (keycode == HRM_I) last_keycode = KC_I;
-            else if (keycode == HRM_O) last_keycode = KC_O;
-            else last_keycode = keycode; // Regular alpha key
+            last_keycode = keycode_base(keycode);
 
             last_key_was_alpha = true;
+            last_alpha_press_time = record->event.time;
         } else {
             last_key_was_alpha = false;
         }
@@ -107,15 +99,13 @@ static void handle_keycode_tracking(uint16_t keycode, keyrecord_t *record) {
             if (is_alpha) {
                 // Capitalize alpha keys (including homerow mods)
                 add_oneshot_mods(MOD_BIT(KC_LSFT));
-            } else if (keycode == KC_MINS || keycode == KC_UNDS) {
-                // Allow minus/underscore in caps-word
-                // Do nothing, let it pass through
-            } else if (keycode == KC_BSPC || keycode == KC_DEL) {
-                // Allow backspace/delete in caps-word
+            } else if (classes & KCC_CAPS_WORD) {
+                // Allow minus/underscore and backspace/delete in caps-word
                 // Do nothing, let it pass through
             } else {
                 // Any other key cancels caps-word
                 caps_word_active = false;
+                rgb_indicator_mode(RGB_IND_CAPS_WORD, false);
             }
         }
     }
@@ -126,25 +116,12 @@ static void handle_keycode_tracking(uint16_t keycode, keyrecord_t *record) {
  * ║  Tap = num-word (auto-exits on non-number keys), Hold = momentary NUM layer                        ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-static bool handle_smart_num_key(uint16_t keycode, keyrecord_t *record) {
-    if (keycode == SMART_NUM) {
-        if (record->event.pressed) {
-            smart_num_tap_timer = timer_read();
-            layer_on(_NUM);  // Activate layer immediately for hold behavior
-        } else {
-            // On release, check if it was a tap or hold
-            if (timer_elapsed(smart_num_tap_timer) < TAPPING_TERM) {
-                // TAP: Activate Numword mode
-                num_word_active = true;
-                // Layer stays on via num_word_active flag
-            } else {
-                // HOLD: Was acting as momentary layer, now release it
-                layer_off(_NUM);
-            }
-        }
-        return false;
-    }
-    return true;
+// Tap action - hold (buffered momentary NUM) is handled by the hold-tap engine
+static void smart_num_tap(void) {
+    // Activate Numword mode - layer stays on via num_word_active flag
+    num_word_active = true;
+    rgb_indicator_mode(RGB_IND_NUM_WORD, true);
+    layer_on(_NUM);
 }
 
 /* ╔═══════════════════════════════════════════════════════════════════════════════════════════════════╗
@@ -152,393 +129,136 @@ static bool handle_smart_num_key(uint16_t keycode, keyrecord_t *record) {
  * ║  Single tap = repeat last alpha or sticky shift, Double tap = caps-word, Hold = shift             ║
  * ╚═══════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-static bool handle_magic_shift_key(uint16_t keycode, keyrecord_t *record) {
-    if (keycode == MAGIC_SHIFT) {
-        if (record->event.pressed) {
-            magic_shift_timer = timer_read();
-            register_mods(MOD_BIT(KC_LSFT));
+// Tap action - hold (eager Shift) is handled by the hold-tap engine
+static void magic_shift_tap(void) {
+    // Check for double-tap (caps-word)
+    if (timer_elapsed(magic_shift_tap_timer) < TAPPING_TERM) {
+        caps_word_active = true;
+        rgb_indicator_mode(RGB_IND_CAPS_WORD, true);
+        magic_shift_tap_timer = 0; // Reset timer
+    } else {
+        // Single tap: context-sensitive behavior
+        if (last_key_was_alpha && last_keycode != KC_NO) {
+            // Repeat last alpha character
+            tap_code(last_keycode);
         } else {
-            unregister_mods(MOD_BIT(KC_LSFT));
-            if (timer_elapsed(magic_shift_timer) < TAPPING_TERM) {
-                // Check for double-tap (caps-word)
-                if (timer_elapsed(magic_shift_tap_timer) < TAPPING_TERM) {
-                    caps_word_active = true;
-                    magic_shift_tap_timer = 0; // Reset timer
-                } else {
-                    // Single tap: context-sensitive behavior
-                    if (last_key_was_alpha && last_keycode != KC_NO) {
-                        // Repeat last alpha character
-                        tap_code(last_keycode);
-                    } else {
-                        // Sticky shift for next character
-                        set_oneshot_mods(MOD_BIT(KC_LSFT));
-                    }
-                    magic_shift_tap_timer = timer_read(); // Start double-tap timer
-                }
-            }
+            // Sticky shift for next character
+            set_oneshot_mods(MOD_BIT(KC_LSFT));
         }
-        return false;
+        magic_shift_tap_timer = timer_read(); // Start double-tap timer
     }
-    return true;
 }
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  LEADER KEY SEQUENCES                                                                              ║
  * ║  International character input via leader + key combinations                                       ║
+ * ║  Sequences live in leader_sequences.txt, compiled by leader_gen.py into the PROGMEM leader_trie[]  ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-static bool handle_leader_key(uint16_t keycode, keyrecord_t *record) {
-    if (keycode == LEADER || keycode == LEADER_SFT) {
-        if (record->event.pressed) {
-            // If LEADER_SFT, activate one-shot shift first
-            if (keycode == LEADER_SFT) {
-                add_oneshot_mods(MOD_BIT(KC_LSFT));
-            }
-            leader_active = true;
-            leader_timer = timer_read();
-            leader_sequence_count = 0;
-            for (int i = 0; i < 3; i++) {
-                leader_sequence[i] = KC_NO;
+static void leader_end(void) {
+    leader_active = false;
+    rgb_indicator_mode(RGB_IND_LEADER, false);
+    leader_node = 0;
+    cancel_deferred_exec(leader_timeout_token);
+    leader_timeout_token = INVALID_DEFERRED_TOKEN;
+}
+
+// Perform a node's action - the root and prefix-only nodes do nothing
+static void leader_emit(uint16_t index, bool shift) {
+    leader_node_t node;
+    memcpy_P(&node, &leader_trie[index], sizeof(node));
+    #ifdef RAW_ENABLE
+        if (node.action != LEADER_ACT_NONE) usage_count_leader(index);
+    #endif
+
+    #ifdef UNICODE_COMMON_ENABLE
+    switch (node.action) {
+        case LEADER_ACT_UNICODE:
+            if (shift && node.upper != node.lower) {
+                del_mods(MOD_MASK_SHIFT);
+                del_oneshot_mods(MOD_MASK_SHIFT);
+                register_unicode(node.upper);
+            } else {
+                register_unicode(node.lower);
             }
-        }
-        return false;
+            break;
+        case LEADER_ACT_MODE:
+            set_unicode_input_mode(node.lower);
+            break;
     }
-    return true;
+    #endif
 }
 
-static bool handle_leader_sequences(uint16_t keycode, keyrecord_t *record) {
-    if (leader_active && record->event.pressed) {
-        if (timer_elapsed(leader_timer) > 3000) {
-            // Leader timeout
-            leader_active = false;
-            leader_sequence_count = 0;
-            return true;
-        }
-
-        // Add key to sequence
-        if (leader_sequence_count < 3) {
-            leader_sequence[leader_sequence_count++] = keycode;
-        }
+// Child of a node reached by a basic keycode, or 0 - one depth level per key
+static uint16_t leader_find_child(uint16_t parent, uint8_t key) {
+    uint16_t first = pgm_read_word(&leader_trie[parent].first_child);
+    uint8_t  count = pgm_read_byte(&leader_trie[parent].child_count);
 
-        // Check for shift state for uppercase variants (including one-shot mods)
-        bool shift_held = (get_mods() | get_oneshot_mods()) & MOD_MASK_SHIFT;
-
-        // Check for 3-key sequences (MAC, WIN, LIN)
-        if (leader_sequence_count == 3) {
-            // MAC sequence: M A C
-            if (leader_sequence[0] == KC_M && leader_sequence[1] == KC_A && leader_sequence[2] == KC_C) {
-                set_unicode_input_mode(UNICODE_MODE_MACOS);
-                leader_active = false;
-                leader_sequence_count = 0;
-                return false;
-            }
-            // WIN sequence: W I N
-            if (leader_sequence[0] == KC_W && leader_sequence[1] == HRM_I && leader_sequence[2] == HRM_N) {
-                set_unicode_input_mode(UNICODE_MODE_WINCOMPOSE);
-                leader_active = false;
-                leader_sequence_count = 0;
-                return false;
-            }
-            // LIN sequence: L I N
-            if (leader_sequence[0] == KC_L && leader_sequence[1] == HRM_I && leader_sequence[2] == HRM_N) {
-                set_unicode_input_mode(UNICODE_MODE_LINUX);
-                leader_active = false;
-                leader_sequence_count = 0;
-                return false;
-            }
-            // If no match, cancel leader
-            leader_active = false;
-            leader_sequence_count = 0;
-            return true;
-        }
-
-        // Check for 2-key sequences (French accents, ligatures)
-        if (leader_sequence_count == 2) {
-            uint16_t first = leader_sequence[0];
-            uint16_t second = leader_sequence[1];
-
-            // French E accents: E + modifier
-            if (first == KC_E || first == HRM_E) {
-                if (second == KC_G) {  // E G → è/È (grave)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C8);  // È
-                    } else {
-                        register_unicode(0x00E8);  // è
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_C) {  // E C → ê/Ê (circumflex)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00CA);  // Ê
-                    } else {
-                        register_unicode(0x00EA);  // ê
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_D) {  // E D → ë/Ë (diaeresis)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00CB);  // Ë
-                    } else {
-                        register_unicode(0x00EB);  // ë
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                }
-            }
+    for (uint16_t i = first; i < first + count; i++) {
+        uint8_t child_key = pgm_read_byte(&leader_trie[i].key);
+        if (child_key == key) return i;
+        if (child_key > key) break;  // Children are sorted by key
+    }
+    return 0;
+}
 
-            // French A accents: A + modifier
-            if (first == KC_A || first == HRM_A) {
-                if (second == KC_G) {  // A G → à/À (grave)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C0);  // À
-                    } else {
-                        register_unicode(0x00E0);  // à
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_C) {  // A C → â/Â (circumflex)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C2);  // Â
-                    } else {
-                        register_unicode(0x00E2);  // â
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_E || second == HRM_E) {  // A E → æ/Æ (ligature)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C6);  // Æ
-                    } else {
-                        register_unicode(0x00E6);  // æ
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                }
-            }
+// Fires on its own - no need to wait for the next key to notice the timeout
+static uint32_t leader_timeout(uint32_t trigger_time, void *cb_arg) {
+    leader_timeout_token = INVALID_DEFERRED_TOKEN;
+    leader_emit(leader_node, leader_shift);  // Finish a pending prefix match (e.g. a → ä)
+    leader_end();
+    return 0;
+}
 
-            // French O accents: O + modifier
-            if (first == KC_O || first == HRM_O) {
-                if (second == KC_C) {  // O C → ô/Ô (circumflex)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00D4);  // Ô
-                    } else {
-                        register_unicode(0x00F4);  // ô
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_E || second == HRM_E) {  // O E → œ/Œ (ligature)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x0152);  // Œ
-                    } else {
-                        register_unicode(0x0153);  // œ
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                }
-            }
+static void leader_arm_timeout(uint32_t delay) {
+    cancel_deferred_exec(leader_timeout_token);
+    leader_timeout_token = defer_exec(delay, leader_timeout, NULL);
+}
 
-            // French I accents: I + modifier
-            if (first == HRM_I) {
-                if (second == KC_C) {  // I C → î/Î (circumflex)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00CE);  // Î
-                    } else {
-                        register_unicode(0x00EE);  // î
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_D) {  // I D → ï/Ï (diaeresis)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00CF);  // Ï
-                    } else {
-                        register_unicode(0x00EF);  // ï
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                }
-            }
+static bool handle_leader_key(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) {
+        // If LEADER_SFT, activate one-shot shift first
+        if (keycode == LEADER_SFT) {
+            add_oneshot_mods(MOD_BIT(KC_LSFT));
+        }
+        leader_end();  // Restart any sequence in progress
+        leader_active = true;
+        rgb_indicator_mode(RGB_IND_LEADER, true);
+        leader_arm_timeout(LEADER_TIMEOUT);
+    }
+    return false;
+}
 
-            // French U accents: U + modifier
-            if (first == KC_U) {
-                if (second == KC_G) {  // U G → ù/Ù (grave)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00D9);  // Ù
-                    } else {
-                        register_unicode(0x00F9);  // ù
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_C) {  // U C → û/Û (circumflex)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00DB);  // Û
-                    } else {
-                        register_unicode(0x00FB);  // û
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                } else if (second == KC_D) {  // U D → ü/Ü (diaeresis)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00DC);  // Ü
-                    } else {
-                        register_unicode(0x00FC);  // ü
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-                }
-            }
+static bool handle_leader_sequences(uint16_t keycode, keyrecord_t *record, uint8_t mods) {
+    // Homerow mods: a hold (e.g. Shift for uppercase) modifies the sequence, a tap is its letter
+    if (IS_QK_MOD_TAP(keycode)) {
+        if (record->tap.count == 0) return true;
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
 
-            // French Y diaeresis: Y D → ÿ/Ÿ
-            if (first == KC_Y && second == KC_D) {
-                if (shift_held) {
-                    del_mods(MOD_MASK_SHIFT);
-                    del_oneshot_mods(MOD_MASK_SHIFT);
-                    register_unicode(0x0178);  // Ÿ
-                } else {
-                    register_unicode(0x00FF);  // ÿ
-                }
-                leader_active = false;
-                leader_sequence_count = 0;
-                return false;
-            }
+    uint16_t child = keycode <= 0xFF ? leader_find_child(leader_node, keycode) : 0;
+    if (!child) {
+        // Sequence can't continue: finish a pending prefix match and let the key through
+        leader_emit(leader_node, leader_shift);
+        leader_end();
+        return true;
+    }
 
-            // If no 2-key match, might be part of 3-key sequence
-            // Don't cancel yet, wait for third key or timeout
-            return true;
-        }
+    // Shift state for uppercase variants (event snapshot includes one-shot mods)
+    bool shift_held = mods & MOD_MASK_SHIFT;
 
-        // Single-key sequences (German umlauts, single French accents, currency)
-        if (leader_sequence_count == 1) {
-            switch (keycode) {
-                // German umlauts
-                case KC_A:
-                case HRM_A:  // A → ä/Ä
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C4);  // Ä
-                    } else {
-                        register_unicode(0x00E4);  // ä
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                case KC_O:
-                case HRM_O:  // O → ö/Ö
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00D6);  // Ö
-                    } else {
-                        register_unicode(0x00F6);  // ö
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                case KC_U:  // U → ü/Ü
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00DC);  // Ü
-                    } else {
-                        register_unicode(0x00FC);  // ü
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                case KC_S:
-                case HRM_S:  // S → ß
-                    register_unicode(0x00DF);  // ß
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                // French accents (single-key)
-                case KC_E:
-                case HRM_E:  // E → é/É (acute)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C9);  // É
-                    } else {
-                        register_unicode(0x00E9);  // é
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                case KC_C:  // C → ç/Ç (cedilla)
-                    if (shift_held) {
-                        del_mods(MOD_MASK_SHIFT);
-                        del_oneshot_mods(MOD_MASK_SHIFT);
-                        register_unicode(0x00C7);  // Ç
-                    } else {
-                        register_unicode(0x00E7);  // ç
-                    }
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                // Currency symbols
-                case KC_4:  // 4 → € (euro)
-                    register_unicode(0x20AC);  // €
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                case KC_3:  // 3 → £ (pound)
-                    register_unicode(0x00A3);  // £
-                    leader_active = false;
-                    leader_sequence_count = 0;
-                    return false;
-
-                default:
-                    // Don't cancel yet, might be multi-key sequence
-                    break;
-            }
-        }
+    if (pgm_read_byte(&leader_trie[child].child_count) == 0) {
+        leader_emit(child, shift_held);
+        leader_end();
+        return false;
     }
-    return true;
+
+    // Prefix of a longer sequence - a prefix that is complete by itself only waits briefly
+    leader_node  = child;
+    leader_shift = shift_held;
+    leader_arm_timeout(pgm_read_byte(&leader_trie[child].action) == LEADER_ACT_NONE ? LEADER_TIMEOUT
+                                                                                     : LEADER_PREFIX_TIMEOUT);
+    return false;
 }
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
@@ -564,13 +284,8 @@ static bool handle_smart_mouse_key(uint16_t keycode, keyrecord_t *record) {
 
     // Auto-exit mouse layer on key press (except movement/scroll/button keys and modifiers)
     if (smart_mouse_active && record->event.pressed) {
-        bool is_mouse_key = (keycode >= MS_UP && keycode <= MS_RGHT) ||
-                           (keycode >= MS_BTN1 && keycode <= MS_BTN8) ||
-                           (keycode >= MS_WHLU && keycode <= MS_WHLR) ||
-                           (keycode == KC_PGUP || keycode == KC_PGDN) ||
-                           (keycode == KC_LGUI || keycode == KC_LALT ||
-                            keycode == KC_LSFT || keycode == KC_LCTL ||
-                            keycode == SMART_MOUSE || keycode == MOUSE);
+        bool is_mouse_key = keycode_is(keycode, KCC_MOUSE) ||  // Movement, buttons, scroll, PgUp/Dn, mods
+                            keycode == SMART_MOUSE || keycode == MOUSE;
 
         if (!is_mouse_key) {
             smart_mouse_active = false;
@@ -658,10 +373,7 @@ static bool handle_alt_tab_swapper(uint16_t keycode, keyrecord_t *record) {
 
     // Cancel swapper on any other key press (except ignored keys)
     if (alt_tab_active && record->event.pressed) {
-        bool is_ignored_key = (keycode == ALT_TAB_FWD || keycode == ALT_TAB_REV ||
-                              keycode == KC_LSFT || keycode == KC_RSFT ||
-                              keycode == KC_LCTL || keycode == KC_RCTL ||
-                              keycode == KC_LGUI || keycode == KC_RGUI);
+        bool is_ignored_key = keycode_is(keycode, KCC_ALT_TAB);  // Shift, Ctrl, GUI
 
         if (!is_ignored_key) {
             alt_tab_active = false;
@@ -677,157 +389,164 @@ static bool handle_alt_tab_swapper(uint16_t keycode, keyrecord_t *record) {
  * ║  Tap = space, Hold = NAV layer, Shift+Tap = . then space then sticky-shift                        ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-static bool handle_smart_spc_key(uint16_t keycode, keyrecord_t *record) {
-    if (keycode == SMART_SPC) {
-        if (record->event.pressed) {
-            smart_spc_timer = timer_read();
-            layer_on(_NAV);  // Activate NAV layer on hold
-        } else {
-            layer_off(_NAV);  // Deactivate NAV layer on release
-
-            // Check if it was a tap (not a hold)
-            if (timer_elapsed(smart_spc_timer) < TAPPING_TERM) {
-                // Check if shift is held
-                if (get_mods() & MOD_MASK_SHIFT) {
-                    // Shift + tap: output . then space then activate sticky shift
-                    del_mods(MOD_MASK_SHIFT);  // Temporarily remove shift
-                    tap_code(KC_DOT);          // Type dot
-                    tap_code(KC_SPC);          // Type space
-                    set_oneshot_mods(MOD_BIT(KC_LSFT));  // Activate sticky shift for next char
-                } else {
-                    // Normal tap: just space
-                    tap_code(KC_SPC);
-                }
-            }
-        }
-        return false;
+// Tap action - hold (buffered NAV layer) is handled by the hold-tap engine
+static void smart_spc_tap(void) {
+    // Check if shift is held
+    if (get_mods() & MOD_MASK_SHIFT) {
+        // Shift + tap: output . then space then activate sticky shift
+        del_mods(MOD_MASK_SHIFT);  // Temporarily remove shift
+        tap_code(KC_DOT);          // Type dot
+        tap_code(KC_SPC);          // Type space
+        set_oneshot_mods(MOD_BIT(KC_LSFT));  // Activate sticky shift for next char
+    } else {
+        // Normal tap: just space
+        tap_code(KC_SPC);
     }
-    return true;
 }
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
- * ║  SOCD CLEANING (SIMULTANEOUS OPPOSITE CARDINAL DIRECTIONS)                                        ║
- * ║  Last Input Priority (LIP) for W/A/S/D - prevents impossible inputs in competitive games           ║
+ * ║  HOLD-TAP DESCRIPTOR TABLE                                                                         ║
+ * ║  Every custom dual-role key - resolved by the engine in hold_tap.h                                 ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-static void handle_socd_cleaning(uint16_t keycode, keyrecord_t *record) {
-    // Only apply SOCD cleaning on gaming layer
-    if (get_highest_layer(default_layer_state) != _GAMING) {
-        return;
-    }
+const hold_tap_def_t hold_tap_defs[] = {
+    // keycode     tap      hold               term          hold kind      flavor            streak rules
+    {SMART_SPC,   KC_NO,   _NAV,              TAPPING_TERM, HT_HOLD_LAYER, HT_BALANCED,      HT_BUFFERED | HT_STREAK_IDLE, smart_spc_tap},
+    {SMART_NUM,   KC_NO,   _NUM,              TAPPING_TERM, HT_HOLD_LAYER, HT_BALANCED,      HT_BUFFERED | HT_STREAK_IDLE, smart_num_tap},
+    {MAGIC_SHIFT, KC_NO,   MOD_BIT(KC_LSFT),  TAPPING_TERM, HT_HOLD_MODS,  HT_TAP_PREFERRED, HT_EAGER,                     magic_shift_tap},
+
+    // urob-style navigation hold-taps (tap = movement, hold = jump, rapid re-press = key repeat)
+    {U_NAV_U,     KC_UP,   C(KC_HOME),        TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+    {U_NAV_D,     KC_DOWN, C(KC_END),         TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+    {U_NAV_L,     KC_LEFT, KC_HOME,           TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+    {U_NAV_R,     KC_RGHT, KC_END,            TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+    {U_NAV_BS,    KC_BSPC, C(KC_BSPC),        TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+    {U_NAV_DEL,   KC_DEL,  C(KC_DEL),         TAPPING_TERM, HT_HOLD_KEY,   HT_TAP_PREFERRED, HT_STREAK_REPEAT,             NULL},
+};
+const uint8_t hold_tap_def_count = ARRAY_SIZE(hold_tap_defs);
 
-    // Vertical axis (W/S)
-    if (keycode == KC_W) {
-        if (record->event.pressed) {
-            socd_w_pressed = true;
-            socd_last_vertical = KC_W;
-            // If S is held, release it (Last Input Priority)
-            if (socd_s_pressed) {
-                unregister_code(KC_S);
-            }
-            register_code(KC_W);
-        } else {
-            socd_w_pressed = false;
-            unregister_code(KC_W);
-            // If S was being held, re-register it
-            if (socd_s_pressed) {
-                register_code(KC_S);
-            }
-        }
-    } else if (keycode == KC_S) {
-        if (record->event.pressed) {
-            socd_s_pressed = true;
-            socd_last_vertical = KC_S;
-            // If W is held, release it (Last Input Priority)
-            if (socd_w_pressed) {
-                unregister_code(KC_W);
-            }
-            register_code(KC_S);
-        } else {
-            socd_s_pressed = false;
-            unregister_code(KC_S);
-            // If W was being held, re-register it
-            if (socd_w_pressed) {
-                register_code(KC_W);
-            }
-        }
-    }
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  SOCD PAIR TABLE (SIMULTANEOUS OPPOSITE CARDINAL DIRECTIONS)                                       ║
+ * ║  Opposing keys resolved by the engine in socd.h while GAMING is the default layer                  ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
-    // Horizontal axis (A/D)
-    if (keycode == KC_A) {
-        if (record->event.pressed) {
-            socd_a_pressed = true;
-            socd_last_horizontal = KC_A;
-            // If D is held, release it (Last Input Priority)
-            if (socd_d_pressed) {
-                unregister_code(KC_D);
-            }
-            register_code(KC_A);
-        } else {
-            socd_a_pressed = false;
-            unregister_code(KC_A);
-            // If D was being held, re-register it
-            if (socd_d_pressed) {
-                register_code(KC_D);
-            }
-        }
-    } else if (keycode == KC_D) {
-        if (record->event.pressed) {
-            socd_d_pressed = true;
-            socd_last_horizontal = KC_D;
-            // If A is held, release it (Last Input Priority)
-            if (socd_a_pressed) {
-                unregister_code(KC_A);
-            }
-            register_code(KC_D);
-        } else {
-            socd_d_pressed = false;
-            unregister_code(KC_D);
-            // If A was being held, re-register it
-            if (socd_a_pressed) {
-                register_code(KC_A);
-            }
-        }
-    }
+const socd_pair_t socd_pairs[] = {
+    // keys[0]  keys[1]   mode
+    {{KC_W,    KC_S},    SOCD_LAST},
+    {{KC_A,    KC_D},    SOCD_LAST},
+    {{KC_UP,   KC_DOWN}, SOCD_LAST},
+    {{KC_LEFT, KC_RGHT}, SOCD_LAST},
+};
+const uint8_t socd_pair_count = ARRAY_SIZE(socd_pairs);
+_Static_assert(ARRAY_SIZE(socd_pairs) <= SOCD_MAX_PAIRS, "socd_pairs[] outgrew the 16-bit held/sent masks");
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  KEYCODE OWNERSHIP TABLE                                                                           ║
+ * ║  Custom keycode → the one handler that owns it, built at compile time from the keycode enum        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum smart_owner {
+    SB_NONE,      // Not a smart key - only the state observers may react
+    SB_ALT_TAB,   // handle_alt_tab_swapper
+    SB_MOUSE,     // handle_smart_mouse_key
+    SB_HOLD_TAP,  // process_hold_tap (hold_tap_defs[])
+    SB_LEADER,    // handle_leader_key
+    SB_DESKTOP,   // handle_desktop_keys
+};
+
+// Indexed by keycode - SAFE_RANGE; sized by the highest designated entry
+static const uint8_t smart_owner_table[] PROGMEM = {
+    [ALT_TAB_FWD - SAFE_RANGE] = SB_ALT_TAB,
+    [ALT_TAB_REV - SAFE_RANGE] = SB_ALT_TAB,
+    [SMART_MOUSE - SAFE_RANGE] = SB_MOUSE,
+    [SMART_SPC   - SAFE_RANGE] = SB_HOLD_TAP,
+    [SMART_NUM   - SAFE_RANGE] = SB_HOLD_TAP,
+    [MAGIC_SHIFT - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_U     - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_D     - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_L     - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_R     - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_BS    - SAFE_RANGE] = SB_HOLD_TAP,
+    [U_NAV_DEL   - SAFE_RANGE] = SB_HOLD_TAP,
+    [LEADER      - SAFE_RANGE] = SB_LEADER,
+    [LEADER_SFT  - SAFE_RANGE] = SB_LEADER,
+    [DSK_PREV    - SAFE_RANGE] = SB_DESKTOP,
+    [DSK_NEXT    - SAFE_RANGE] = SB_DESKTOP,
+    [PIN_WIN     - SAFE_RANGE] = SB_DESKTOP,
+    [PIN_APP     - SAFE_RANGE] = SB_DESKTOP,
+    [DSK_MGR     - SAFE_RANGE] = SB_DESKTOP,
+};
+
+static inline uint8_t smart_owner(uint16_t keycode) {
+    if (keycode < SAFE_RANGE || keycode >= SAFE_RANGE + ARRAY_SIZE(smart_owner_table)) return SB_NONE;
+    return pgm_read_byte(&smart_owner_table[keycode - SAFE_RANGE]);
 }
 
 /* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
  * ║  MAIN SMART BEHAVIOR PROCESSOR                                                                     ║
- * ║  Central dispatch function for all intelligent behaviors                                           ║
+ * ║  Snapshot shared state once, run only the observers whose mode is active, jump to the owner        ║
  * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
 
+// Per-event state read once and shared by every handler
+typedef struct {
+    uint8_t default_layer;  // get_highest_layer(default_layer_state)
+    uint8_t mods;           // Held + one-shot mods
+    bool    typing_streak;  // Taken before keycode tracking overwrites the previous key
+} smart_event_t;
+
+#ifdef SCAN_PROFILER_ENABLE
+// Event kind for the profiler's per-call cost table
+static uint8_t smart_event_kind(uint16_t keycode, uint8_t default_layer) {
+    if (default_layer == _GAMING) return PEV_GAMING;
+    if (leader_active) return PEV_LEADER;
+    if (smart_owner(keycode) == SB_HOLD_TAP) return PEV_HOLD_TAP;
+    return keycode_is(keycode, KCC_ALPHA) ? PEV_ALPHA : PEV_OTHER;
+}
+#endif
+
 bool process_smart_behaviors(uint16_t keycode, keyrecord_t *record) {
-    // Handle SOCD cleaning for gaming layer (must be first to intercept W/A/S/D)
-    if (get_highest_layer(default_layer_state) == _GAMING) {
-        if (keycode == KC_W || keycode == KC_A || keycode == KC_S || keycode == KC_D) {
-            handle_socd_cleaning(keycode, record);
-            return false;  // SOCD handler manages the keycode completely
+    smart_event_t ev = {
+        .default_layer = get_highest_layer(default_layer_state),
+        .mods          = get_mods() | get_oneshot_mods(),
+        .typing_streak = record->event.pressed && in_typing_streak(record),
+    };
+    PROFILE_EVENT(smart_event_kind(keycode, ev.default_layer));
+
+    // SOCD pairs on the gaming layer (must be first to intercept the directions)
+    if (!process_socd(keycode, record, ev.default_layer == _GAMING)) return false;
+
+    uint8_t owner = smart_owner(keycode);
+
+    // Releases only matter to the owning handler - every observer reacts to presses alone
+    if (!record->event.pressed) {
+        switch (owner) {
+            case SB_NONE:     return true;
+            case SB_HOLD_TAP: return process_hold_tap(keycode, record, false);
+            default:          return false;  // Press-only smart keys swallow their release
         }
     }
 
-    // Handle Alt+Tab swapper first (affects global modifiers)
-    if (!handle_alt_tab_swapper(keycode, record)) return false;
-
-    // Handle smart mouse first (may affect layer state)
-    if (!handle_smart_mouse_key(keycode, record)) return false;
+    // Alt+Tab swapper first (affects global modifiers)
+    if ((owner == SB_ALT_TAB || alt_tab_active) && !handle_alt_tab_swapper(keycode, record)) return false;
 
-    // Handle smart space key (lt_spc behavior)
-    if (!handle_smart_spc_key(keycode, record)) return false;
+    // Smart mouse next (may affect layer state)
+    if ((owner == SB_MOUSE || smart_mouse_active) && !handle_smart_mouse_key(keycode, record)) return false;
 
-    // Handle num-word logic first (affects layer state)
-    handle_num_word_logic(keycode, record);
+    // Num-word auto-exit (affects layer state)
+    if (num_word_active) handle_num_word_logic(keycode, record);
 
-    // Handle keycode tracking and caps-word
+    // Keycode tracking and caps-word run on every press
     handle_keycode_tracking(keycode, record);
 
-    // Handle specific smart keys
-    if (!handle_smart_num_key(keycode, record)) return false;
-    if (!handle_magic_shift_key(keycode, record)) return false;
-    if (!handle_leader_key(keycode, record)) return false;
-    if (!handle_desktop_keys(keycode, record)) return false;
+    switch (owner) {
+        case SB_HOLD_TAP: return process_hold_tap(keycode, record, ev.typing_streak);
+        case SB_LEADER:   return handle_leader_key(keycode, record);
+        case SB_DESKTOP:  return handle_desktop_keys(keycode, record);
+        default:          break;
+    }
 
-    // Handle leader sequences
-    if (!handle_leader_sequences(keycode, record)) return false;
+    // Leader sequences consume the keys typed after LEADER
+    if (leader_active) return handle_leader_sequences(keycode, record, ev.mods);
 
     return true;
 }
@@ -0,0 +1,94 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * SOCD ENGINE (SIMULTANEOUS OPPOSITE CARDINAL DIRECTIONS)
+ * Table-driven resolution of opposing key pairs with a selectable mode per pair
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  PAIR DESCRIPTORS                                                                                  ║
+ * ║  One const entry per opposing pair - the table lives in smart_behaviors.h                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// What goes out while both keys of a pair are held
+enum socd_mode {
+    SOCD_LAST,      // Last input wins, the other comes back when it's released (snap tap)
+    SOCD_FIRST,     // First input wins, the second waits for it to be released
+    SOCD_NEUTRAL,   // Neither - both directions cancel out
+    SOCD_ABSOLUTE,  // keys[0] always wins (e.g. jump over crouch)
+};
+
+typedef struct {
+    uint16_t keys[2];  // Basic, non-modifier keycodes
+    uint8_t  mode;     // enum socd_mode
+} socd_pair_t;
+
+extern const socd_pair_t socd_pairs[];
+extern const uint8_t     socd_pair_count;
+
+#define SOCD_MAX_PAIRS 8
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  STATE                                                                                             ║
+ * ║  Bit 2×pair + side - held is the physical keys, sent is what the host sees                         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static uint16_t socd_held = 0;
+static uint16_t socd_sent = 0;
+static uint8_t  socd_last = 0;  // Bit per pair: side pressed most recently
+
+// Held bits → the bits to send for one pair
+static inline uint8_t socd_resolve(uint8_t pair, uint8_t held) {
+    if (held != 0x3) return held;  // Zero or one key down: nothing to resolve
+
+    switch (socd_pairs[pair].mode) {
+        case SOCD_LAST:     return 1 << ((socd_last >> pair) & 1);
+        case SOCD_FIRST:    return 1 << (~(socd_last >> pair) & 1);
+        case SOCD_ABSOLUTE: return 0x1;
+        default:            return 0;  // SOCD_NEUTRAL
+    }
+}
+
+// Returns false when the key belongs to a pair - releases are always taken, so a direction held
+// while SOCD is switched off (leaving GAMING) can't stick
+bool process_socd(uint16_t keycode, keyrecord_t *record, bool active) {
+    uint8_t pair = 0, side = 0;
+    for (; pair < socd_pair_count; pair++) {
+        if (socd_pairs[pair].keys[0] == keycode) break;
+        if (socd_pairs[pair].keys[1] == keycode) {
+            side = 1;
+            break;
+        }
+    }
+    if (pair == socd_pair_count) return true;
+
+    uint8_t  shift = pair * 2;
+    uint16_t bit   = 1 << (shift + side);
+    if (record->event.pressed) {
+        if (!active) return true;
+        socd_held |= bit;
+        socd_last  = (socd_last & ~(1 << pair)) | (side << pair);
+    } else {
+        if (!(socd_held & bit)) return true;
+        socd_held &= ~bit;
+    }
+
+    // Only this pair can change - apply the difference and send it as one report
+    uint8_t sent    = (socd_sent >> shift) & 0x3;
+    uint8_t target  = socd_resolve(pair, (socd_held >> shift) & 0x3);
+    uint8_t changed = sent ^ target;
+    if (!changed) return false;
+
+    for (uint8_t s = 0; s < 2; s++) {
+        if (!(changed & (1 << s))) continue;
+        if (target & (1 << s)) add_key(socd_pairs[pair].keys[s]);
+        else                   del_key(socd_pairs[pair].keys[s]);
+    }
+    send_keyboard_report();
+    socd_sent = (socd_sent & ~(0x3 << shift)) | (target << shift);
+    return false;
+}
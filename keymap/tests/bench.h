@@ -0,0 +1,136 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST BENCHMARK HELPERS
+ * Wall time, CPU cycles and retired user-space instructions per call, one JSON object per line on stdout
+ * Cycles and instructions come from perf_event_open - null where the kernel refuses it
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#endif
+
+typedef struct {
+    uint64_t ns;
+    uint64_t cycles;
+    uint64_t insns;
+    uint64_t calls;
+    uint64_t regions;
+} bench_sample_t;
+
+enum { BENCH_CYCLES, BENCH_INSNS, BENCH_COUNTERS };
+
+static int            bench_perf_fd[BENCH_COUNTERS] = {-1, -1};
+static bench_sample_t bench_overhead;  // An empty timed region - subtracted from every report
+
+// Tuning knobs (argv[1] overrides - ctest runs a short smoke pass)
+#ifndef BENCH_ITERATIONS
+#    define BENCH_ITERATIONS 200000
+#endif
+
+static inline uint32_t bench_iterations(int argc, char **argv) {
+    return argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_ITERATIONS;
+}
+
+static inline uint64_t bench_clock_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static inline uint64_t bench_counter(uint8_t counter) {
+    uint64_t count = 0;
+#ifdef __linux__
+    int fd = bench_perf_fd[counter];
+    if (fd >= 0 && read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+    return count;
+}
+
+static inline void bench_counters_enable(bool enable) {
+#ifdef __linux__
+    for (uint8_t c = 0; c < BENCH_COUNTERS; c++) {
+        if (bench_perf_fd[c] >= 0) ioctl(bench_perf_fd[c], enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+// Timed region - everything between begin and end is billed to `calls` calls
+static inline void bench_begin(bench_sample_t *sample) {
+    bench_counters_enable(true);
+    sample->insns -= bench_counter(BENCH_INSNS);
+    sample->cycles -= bench_counter(BENCH_CYCLES);
+    sample->ns -= bench_clock_ns();
+}
+
+static inline void bench_end(bench_sample_t *sample, uint32_t calls) {
+    sample->ns += bench_clock_ns();
+    sample->cycles += bench_counter(BENCH_CYCLES);
+    sample->insns += bench_counter(BENCH_INSNS);
+    bench_counters_enable(false);
+    sample->calls += calls;
+    sample->regions++;
+}
+
+// Cost of begin/end themselves, from empty regions
+static inline void bench_calibrate(void) {
+    memset(&bench_overhead, 0, sizeof(bench_overhead));
+    for (uint32_t i = 0; i < 10000; i++) {
+        bench_begin(&bench_overhead);
+        bench_end(&bench_overhead, 0);
+    }
+}
+
+static inline void bench_init(void) {
+#ifdef __linux__
+    static const uint64_t configs[BENCH_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS};
+    for (uint8_t c = 0; c < BENCH_COUNTERS; c++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(attr);
+        attr.config         = configs[c];
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        bench_perf_fd[c]    = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+    bench_calibrate();
+}
+
+// {"bench":..., "case":..., "calls":..., "ns_per_call":..., "cycles_per_call":..., "insns_per_call":...}
+// - extra is appended verbatim
+static inline void bench_report(const char *bench, const char *name, const bench_sample_t *sample, const char *extra) {
+    double calls   = sample->calls ? (double)sample->calls : 1;
+    double regions = bench_overhead.regions ? (double)sample->regions / bench_overhead.regions : 0;
+    double ns      = (double)sample->ns - regions * bench_overhead.ns;
+    double counts[BENCH_COUNTERS] = {
+        [BENCH_CYCLES] = (double)sample->cycles - regions * bench_overhead.cycles,
+        [BENCH_INSNS]  = (double)sample->insns - regions * bench_overhead.insns,
+    };
+    static const char *const names[BENCH_COUNTERS] = {"cycles_per_call", "insns_per_call"};
+
+    printf("{\"bench\":\"%s\",\"case\":\"%s\",\"calls\":%llu,\"ns_per_call\":%.1f", bench, name,
+           (unsigned long long)sample->calls, (ns > 0 ? ns : 0) / calls);
+    for (uint8_t c = 0; c < BENCH_COUNTERS; c++) {
+        if (bench_perf_fd[c] >= 0) {
+            printf(",\"%s\":%.1f", names[c], (counts[c] > 0 ? counts[c] : 0) / calls);
+        } else {
+            printf(",\"%s\":null", names[c]);
+        }
+    }
+    printf("%s%s}\n", extra ? "," : "", extra ? extra : "");
+    fflush(stdout);
+}
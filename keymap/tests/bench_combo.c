@@ -0,0 +1,155 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * COMBO LOOKUP SCALING BENCHMARK
+ * combo_engine.h over a synthetic table of BENCH_COMBOS two-key combos (32, 64, 128, 256 - one binary
+ * each), spread over the 36 alpha positions - per-key cost should stay flat as the table grows
+ *   bench_combo_256 [iterations]
+ */
+
+#include QMK_KEYBOARD_H
+
+// The engine alone - no telemetry, usage counters or tracing in the timed path
+#undef COMBO_TELEMETRY_ENABLE
+#undef RAW_ENABLE
+#undef LATENCY_TRACE_ENABLE
+
+#define COMBO_LENGTH BENCH_COMBOS
+_Static_assert(COMBO_LENGTH == 32 || COMBO_LENGTH == 64 || COMBO_LENGTH == 128 || COMBO_LENGTH == 256,
+               "BENCH_COMBOS must be 32, 64, 128 or 256");
+
+#include "combo_engine.h"
+#include "bench.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  SYNTHETIC COMBO TABLE                                                                             ║
+ * ║  Combo positions are matrix row * MATRIX_COLS + col - alpha rows only, thumbs never in a combo     ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define BENCH_ALPHA_POSITIONS 36
+#define BENCH_THUMB_POSITION  42  // Matrix row 7 - passthrough key
+
+static uint8_t bench_keys[COMBO_LENGTH][3];  // Filled by bench_combo_table() before the engine indexes it
+
+#define BENCH_DEF(i)    {bench_keys[i], KC_A + (i) % 26, NULL, COMBO_ALL_LAYERS, COMBO_TERM},
+#define BENCH_DEF4(i)   BENCH_DEF(i) BENCH_DEF(i + 1) BENCH_DEF(i + 2) BENCH_DEF(i + 3)
+#define BENCH_DEF16(i)  BENCH_DEF4(i) BENCH_DEF4(i + 4) BENCH_DEF4(i + 8) BENCH_DEF4(i + 12)
+#define BENCH_DEF32(i)  BENCH_DEF16(i) BENCH_DEF16(i + 16)
+
+const combo_def_t combo_defs[COMBO_LENGTH] = {
+    BENCH_DEF32(0)
+#if COMBO_LENGTH > 32
+    BENCH_DEF32(32)
+#endif
+#if COMBO_LENGTH > 64
+    BENCH_DEF32(64) BENCH_DEF32(96)
+#endif
+#if COMBO_LENGTH > 128
+    BENCH_DEF32(128) BENCH_DEF32(160) BENCH_DEF32(192) BENCH_DEF32(224)
+#endif
+};
+
+const uint8_t combo_position_map[MATRIX_ROWS][MATRIX_COLS] = {
+    {0, 1, 2, 3, 4, 5},       {6, 7, 8, 9, 10, 11},     {12, 13, 14, 15, 16, 17}, {18, 19, 20, 21, 22, 23},
+    {24, 25, 26, 27, 28, 29}, {30, 31, 32, 33, 34, 35}, {36, 37, 38, 39, 40, 41}, {42, 43, 44, 45, 46, 47},
+};
+
+bool combos_allowed(void) { return true; }
+void combo_action_event(uint16_t index, bool pressed) {}
+
+// Distinct position pairs in a fixed pseudo-random order - every table size is a prefix of the next
+static void bench_combo_table(void) {
+    bool     used[BENCH_ALPHA_POSITIONS][BENCH_ALPHA_POSITIONS] = {{false}};
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < COMBO_LENGTH;) {
+        seed      = seed * 1103515245u + 12345u;
+        uint8_t a = (seed >> 16) % BENCH_ALPHA_POSITIONS;
+        seed      = seed * 1103515245u + 12345u;
+        uint8_t b = (seed >> 16) % BENCH_ALPHA_POSITIONS;
+        if (a == b || used[a][b]) continue;
+        used[a][b] = used[b][a] = true;
+        bench_keys[i][0] = a;
+        bench_keys[i][1] = b;
+        bench_keys[i][2] = COMBO_END;
+        i++;
+    }
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  CASES                                                                                             ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static keyrecord_t bench_record(uint8_t position, bool pressed) {
+    keyrecord_t record = {.event = MAKE_KEYEVENT(position / MATRIX_COLS, position % MATRIX_COLS, pressed)};
+    record.event.time  = timer_read();
+    return record;
+}
+
+static void bench_event(uint8_t position, bool pressed) {
+    keyrecord_t record = bench_record(position, pressed);
+    process_combo_engine(KC_NO, &record);
+}
+
+// Key in no combo: lookup only
+static void bench_passthrough(uint16_t i) {
+    bench_event(BENCH_THUMB_POSITION, true);
+    bench_event(BENCH_THUMB_POSITION, false);
+}
+
+// Typing: a combo key tapped alone - held as a candidate, replayed on its release
+static void bench_typing(uint16_t i) {
+    uint8_t position = bench_keys[i % COMBO_LENGTH][0];
+    bench_event(position, true);
+    bench_event(position, false);
+}
+
+// Both keys of a combo: narrowed to one candidate, fired, released
+static void bench_chord(uint16_t i) {
+    const uint8_t *keys = bench_keys[i % COMBO_LENGTH];
+    bench_event(keys[0], true);
+    bench_event(keys[1], true);
+    bench_event(keys[0], false);
+    bench_event(keys[1], false);
+}
+
+static const struct {
+    const char *name;
+    void (*step)(uint16_t i);
+    uint8_t calls;
+} bench_combo_cases[] = {
+    {"passthrough", bench_passthrough, 2},
+    {"typing",      bench_typing,      2},
+    {"chord",       bench_chord,       4},
+};
+
+int main(int argc, char **argv) {
+    uint32_t iterations = bench_iterations(argc, argv);
+    bench_init();
+    host_init();
+    bench_combo_table();
+    combo_engine_init();
+
+    // Average live candidates a combo key starts with
+    uint32_t candidates = 0, keys = 0;
+    for (uint8_t position = 0; position < BENCH_ALPHA_POSITIONS; position++) {
+        uint32_t count = 0;
+        COMBO_MASK_FOREACH(index, &combo_position_index[position]) count++;
+        if (count) keys++;
+        candidates += count;
+    }
+    char extra[64];
+    snprintf(extra, sizeof(extra), "\"combos\":%d,\"candidates_per_key\":%.1f", COMBO_LENGTH,
+             keys ? (double)candidates / keys : 0);
+
+    for (uint8_t c = 0; c < ARRAY_SIZE(bench_combo_cases); c++) {
+        bench_sample_t sample = {0};
+        for (uint32_t i = 0; i < iterations; i++) {
+            bench_begin(&sample);
+            bench_combo_cases[c].step((uint16_t)i);
+            bench_end(&sample, bench_combo_cases[c].calls);
+            if ((i & 0x3FF) == 0x3FF) host_reports_clear();
+        }
+        bench_report("combo", bench_combo_cases[c].name, &sample, extra);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * SMART BEHAVIOR DISPATCH BENCHMARK
+ * The owner-table dispatch in process_smart_behaviors against the handler chain it replaced - every
+ * handler called in turn, each checking its own keycodes - on the same handlers and the same events
+ *   bench_dispatch [iterations]
+ */
+
+// The whole keymap in this file - the chain needs the static handlers
+#include "keymap.c"
+#include "bench_smart.h"
+
+// process_smart_behaviors before the owner table: default layer looked up per handler, no skipping
+static bool smart_behaviors_chain(uint16_t keycode, keyrecord_t *record) {
+    if (get_highest_layer(default_layer_state) == _GAMING && !process_socd(keycode, record, true)) return false;
+
+    bool typing_streak = record->event.pressed && in_typing_streak(record);
+
+    if (!handle_alt_tab_swapper(keycode, record)) return false;
+    if (!handle_smart_mouse_key(keycode, record)) return false;
+    handle_num_word_logic(keycode, record);
+    handle_keycode_tracking(keycode, record);
+    if (!process_hold_tap(keycode, record, typing_streak)) return false;
+    if ((keycode == LEADER || keycode == LEADER_SFT) && !handle_leader_key(keycode, record)) return false;
+    if (!handle_desktop_keys(keycode, record)) return false;
+    if (leader_active && record->event.pressed) {
+        return handle_leader_sequences(keycode, record, get_mods() | get_oneshot_mods());
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = bench_iterations(argc, argv);
+    bench_init();
+    host_init();
+
+    bench_smart_run("dispatch", smart_behaviors_chain, iterations, "\"handler\":\"chain\"");
+    bench_smart_run("dispatch", process_smart_behaviors, iterations, "\"handler\":\"owner_table\"");
+    return 0;
+}
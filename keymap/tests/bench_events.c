@@ -0,0 +1,22 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * PER-EVENT HANDLER BENCHMARK
+ * process_smart_behaviors on the host-built keymap for the event kinds the scan profiler splits by
+ *   bench_events [iterations] > baseline.json
+ */
+
+#include QMK_KEYBOARD_H
+#include "custom_keycodes.h"
+#include "bench_smart.h"
+
+bool process_smart_behaviors(uint16_t keycode, keyrecord_t *record);
+
+int main(int argc, char **argv) {
+    uint32_t iterations = bench_iterations(argc, argv);
+    bench_init();
+    host_init();
+
+    bench_smart_run("events", process_smart_behaviors, iterations, NULL);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * SMART BEHAVIOR BENCHMARK CASES
+ * The event kinds the scan profiler splits process_smart_behaviors by - alpha, SMART_SPC, a leader
+ * sequence, SOCD on the gaming layer - run through any handler with that signature
+ */
+
+#pragma once
+
+#include "bench.h"
+
+typedef bool (*bench_handler_t)(uint16_t keycode, keyrecord_t *record);
+
+typedef struct {
+    const char *name;
+    uint8_t     default_layer;
+    uint8_t     count;  // Events per step, all timed
+    uint16_t    keycodes[4];
+    bool        pressed[4];
+    uint8_t     grid[4];
+} bench_smart_case_t;
+
+// Positions only matter to the hand table and the typing-streak check
+static const bench_smart_case_t bench_smart_cases[] = {
+    {"alpha",     _DEF,    2, {KC_Q, KC_Q},             {true, false},              {0, 0}},
+    {"smart_spc", _DEF,    2, {SMART_SPC, SMART_SPC},   {true, false},              {40, 40}},
+    {"leader",    _DEF,    3, {LEADER, KC_I, KC_Z},     {true, true, true},         {45, 22, 24}},      // Open, prefix, cancel
+    {"gaming",    _GAMING, 4, {KC_A, KC_D, KC_D, KC_A}, {true, true, false, false}, {13, 15, 15, 13}},  // SOCD pair
+};
+
+static bench_sample_t bench_smart_case(const bench_smart_case_t *bench, bench_handler_t handler, uint32_t iterations) {
+    bench_sample_t sample = {0};
+    default_layer_set((layer_state_t)1 << bench->default_layer);
+    host_idle(1000);  // Out of any typing streak, every timer settled
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        keyrecord_t records[4];
+        for (uint8_t e = 0; e < bench->count; e++) {
+            records[e] = (keyrecord_t){.event = MAKE_KEYEVENT(0, 0, bench->pressed[e])};
+            records[e].event.key  = host_grid_key(bench->grid[e]);
+            records[e].event.time = timer_read();
+        }
+
+        bench_begin(&sample);
+        for (uint8_t e = 0; e < bench->count; e++) {
+            handler(bench->keycodes[e], &records[e]);
+        }
+        bench_end(&sample, bench->count);
+
+        if ((i & 0x3FF) == 0x3FF) host_reports_clear();  // Keep the report log from filling up
+    }
+    default_layer_set(1);
+    return sample;
+}
+
+// One JSON line per case - `extra` tags the handler when a benchmark compares several
+static void bench_smart_run(const char *bench, bench_handler_t handler, uint32_t iterations, const char *extra) {
+    for (uint8_t c = 0; c < ARRAY_SIZE(bench_smart_cases); c++) {
+        bench_sample_t sample = bench_smart_case(&bench_smart_cases[c], handler, iterations);
+        bench_report(bench, bench_smart_cases[c].name, &sample, extra);
+    }
+}
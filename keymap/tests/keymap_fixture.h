@@ -0,0 +1,119 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * KEYMAP TEST FIXTURE
+ * Boots the host-built keymap, presses LAYOUT_planck_grid positions on a virtual clock and reads back
+ * the HID reports with their send times
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "qmk_stub.h"
+#include "custom_keycodes.h"
+}
+
+// LAYOUT_planck_grid positions - row * 12 + column
+enum grid_position : uint8_t {
+    G_Q = 0, G_W = 1, G_F = 2, G_P = 3, G_B = 4, G_J = 7, G_L = 8, G_U = 9, G_Y = 10,
+    G_A = 12, G_R = 13, G_S = 14, G_T = 15, G_G = 16, G_M = 19, G_N = 20, G_E = 21, G_I = 22, G_O = 23,
+    G_Z = 24, G_X = 25, G_C = 26, G_D = 27, G_V = 28, G_K = 31, G_H = 32, G_COMM = 33, G_DOT = 34,
+    G_SPC = 40, G_ENT = 41, G_NUM = 42, G_SHIFT = 43, G_MOUSE = 44, G_MIDI = 46, G_GAMING = 47,
+};
+
+class KeymapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        host_init();
+        idle(1000);  // Boot settles, nothing typed for a while
+        host_reports_clear();
+    }
+
+    void TearDown() override {
+        for (uint8_t grid = 0; grid < GRID_KEYS; grid++) {
+            if (down_[grid]) release(grid);
+        }
+        idle(5000);  // Every timer and deferred callback runs out
+    }
+
+    void press(uint8_t grid) {
+        down_[grid] = true;
+        host_key(grid, true);
+    }
+
+    void release(uint8_t grid) {
+        down_[grid] = false;
+        host_key(grid, false);
+    }
+
+    // One scan per ms - events from press()/release() in the same ms share its scan
+    void idle(uint32_t ms) { host_idle(ms); }
+
+    void tap(uint8_t grid, uint32_t hold_ms = 30) {
+        press(grid);
+        idle(hold_ms);
+        release(grid);
+        idle(1);
+    }
+
+    // Roll: each key goes down `gap` ms after the previous one, all released in order afterwards
+    void roll(std::initializer_list<uint8_t> keys, uint32_t gap, uint32_t hold_ms = 40) {
+        for (uint8_t grid : keys) {
+            press(grid);
+            idle(gap);
+        }
+        idle(hold_ms);
+        for (uint8_t grid : keys) {
+            release(grid);
+            idle(gap);
+        }
+        idle(1);
+    }
+
+    // First report at or after `from` with `code` down, -1 if none
+    long report_time(uint8_t code, uint32_t from = 0) const {
+        for (size_t i = 0; i < host_report_count(); i++) {
+            const host_report_t *report = host_report(i);
+            if (report->time >= from && host_report_has(report, code)) return report->time;
+        }
+        return -1;
+    }
+
+    // First report with any of `mods` set, -1 if none
+    long mods_time(uint8_t mods, uint32_t from = 0) const {
+        for (size_t i = 0; i < host_report_count(); i++) {
+            const host_report_t *report = host_report(i);
+            if (report->time >= from && (report->mods & mods)) return report->time;
+        }
+        return -1;
+    }
+
+    // Keys as they went down, in order - shifted letters upper case, other keys as <code>
+    std::string typed() const {
+        std::string out;
+        host_report_t last = {};
+        for (size_t i = 0; i < host_report_count(); i++) {
+            const host_report_t *report = host_report(i);
+            for (uint16_t code = KC_A; code <= 0xFF; code++) {
+                if (!host_report_has(report, code) || host_report_has(&last, code)) continue;
+                bool shift = report->mods & MOD_MASK_SHIFT;
+                if (code <= KC_Z) {
+                    out += (char)((shift ? 'A' : 'a') + code - KC_A);
+                } else if (code == KC_SPC) {
+                    out += ' ';
+                } else {
+                    out += (shift ? "<S-" : "<") + std::to_string(code) + ">";
+                }
+            }
+            last = *report;
+        }
+        return out;
+    }
+
+    bool down_[GRID_KEYS] = {};
+};
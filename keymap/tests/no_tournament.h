@@ -0,0 +1,11 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * FULL-PIPELINE BUILD
+ * Force-included after config.h for test_latency_full - GAMING without TOURNAMENT_MODE, the "before" of
+ * the tournament latency comparison
+ */
+
+#pragma once
+
+#undef TOURNAMENT_MODE
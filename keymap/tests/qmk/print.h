@@ -0,0 +1,19 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST STUB - print.h
+ * Console output goes to a buffer the tests read back (host_console())
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int uprintf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+#define dprintf(...) ((void)0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,40 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST STUB - process_midi.h
+ * Every message sent is counted, so tests can tell whether a path reached the MIDI device
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t id;
+} MidiDevice;
+
+typedef struct {
+    uint8_t octave;
+    int8_t  transpose;
+    uint8_t velocity;
+    uint8_t channel;
+    uint8_t modulation_interval;
+} midi_config_t;
+
+extern MidiDevice    midi_device;
+extern midi_config_t midi_config;
+
+void midi_send_cc(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t val);
+void midi_send_noteon(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t vel);
+void midi_send_noteoff(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t vel);
+void midi_send_programchange(MidiDevice *device, uint8_t chan, uint8_t num);
+
+uint32_t host_midi_messages(void);  // Messages sent since boot
+
+#ifdef __cplusplus
+}
+#endif
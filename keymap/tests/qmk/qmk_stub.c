@@ -0,0 +1,815 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST QMK STUB
+ * Virtual clock, layers, reports, the tap-hold engine, deferred exec and the action pipeline -
+ * enough of quantum/ and tmk_core/ to run the keymap on a PC, one scan loop per virtual ms
+ */
+
+#include QMK_KEYBOARD_H
+
+#include <stdarg.h>
+#include <stdlib.h>
+
+#include "print.h"
+#include "process_midi.h"
+#include "raw_hid.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  VIRTUAL CLOCK                                                                                     ║
+ * ║  Starts well past 0 - the keymap treats a zero timestamp as "never"                                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define HOST_BOOT_MS 10000
+
+static uint32_t host_ms         = HOST_BOOT_MS;
+static uint32_t host_last_input = HOST_BOOT_MS;
+static bool     host_scan_event = false;  // A matrix event ran during this scan
+
+uint16_t timer_read(void) { return (uint16_t)host_ms; }
+uint32_t timer_read32(void) { return host_ms; }
+uint16_t timer_elapsed(uint16_t last) { return TIMER_DIFF_16(timer_read(), last); }
+uint32_t timer_elapsed32(uint32_t last) { return TIMER_DIFF_32(timer_read32(), last); }
+uint32_t last_input_activity_elapsed(void) { return host_ms - host_last_input; }
+uint32_t host_now(void) { return host_ms; }
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  DEFERRED EXECUTION (quantum/deferred_exec.c)                                                      ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define HOST_DEFERRED_SLOTS 16
+
+typedef struct {
+    deferred_token         token;
+    uint32_t               trigger;
+    deferred_exec_callback callback;
+    void                  *arg;
+} host_deferred_t;
+
+static host_deferred_t host_deferred[HOST_DEFERRED_SLOTS];
+static deferred_token  host_last_token = 0;
+
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    if (!delay_ms) return INVALID_DEFERRED_TOKEN;
+    for (uint8_t i = 0; i < HOST_DEFERRED_SLOTS; i++) {
+        host_deferred_t *entry = &host_deferred[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN) continue;
+        do {
+            host_last_token++;
+        } while (host_last_token == INVALID_DEFERRED_TOKEN);
+        *entry = (host_deferred_t){host_last_token, host_ms + delay_ms, callback, cb_arg};
+        return entry->token;
+    }
+    return INVALID_DEFERRED_TOKEN;
+}
+
+bool cancel_deferred_exec(deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) return false;
+    for (uint8_t i = 0; i < HOST_DEFERRED_SLOTS; i++) {
+        if (host_deferred[i].token == token) {
+            host_deferred[i].token = INVALID_DEFERRED_TOKEN;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
+    if (token == INVALID_DEFERRED_TOKEN || !delay_ms) return false;
+    for (uint8_t i = 0; i < HOST_DEFERRED_SLOTS; i++) {
+        if (host_deferred[i].token == token) {
+            host_deferred[i].trigger = host_ms + delay_ms;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void deferred_exec_task(void) {
+    for (uint8_t i = 0; i < HOST_DEFERRED_SLOTS; i++) {
+        host_deferred_t *entry = &host_deferred[i];
+        if (entry->token == INVALID_DEFERRED_TOKEN || (int32_t)(host_ms - entry->trigger) < 0) continue;
+
+        deferred_token token = entry->token;
+        uint32_t       delay = entry->callback(entry->trigger, entry->arg);
+        if (entry->token != token) continue;  // Cancelled from inside its own callback
+        if (delay) {
+            entry->trigger += delay;
+        } else {
+            entry->token = INVALID_DEFERRED_TOKEN;
+        }
+    }
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  LAYERS (quantum/action_layer.c)                                                                   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define HOST_MAX_LAYERS (sizeof(layer_state_t) * 8)
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+static uint8_t host_layer_cache[MATRIX_ROWS][MATRIX_COLS];
+
+uint8_t get_highest_layer(layer_state_t state) {
+    for (int8_t i = HOST_MAX_LAYERS - 1; i > 0; i--) {
+        if (state & ((layer_state_t)1 << i)) return i;
+    }
+    return 0;
+}
+
+bool layer_state_cmp(layer_state_t state, uint8_t layer) {
+    if (!state) return layer == 0;
+    return (state & ((layer_state_t)1 << layer)) != 0;
+}
+
+bool layer_state_is(uint8_t layer) { return layer_state_cmp(layer_state, layer); }
+
+void layer_state_set(layer_state_t state) {
+    layer_state = layer_state_set_user(state);
+}
+
+void layer_clear(void) { layer_state_set(0); }
+void layer_move(uint8_t layer) { layer_state_set((layer_state_t)1 << layer); }
+void layer_on(uint8_t layer) { layer_state_set(layer_state | ((layer_state_t)1 << layer)); }
+void layer_off(uint8_t layer) { layer_state_set(layer_state & ~((layer_state_t)1 << layer)); }
+void layer_invert(uint8_t layer) { layer_state_set(layer_state ^ ((layer_state_t)1 << layer)); }
+
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_t layer2, uint8_t layer3) {
+    layer_state_t mask12 = ((layer_state_t)1 << layer1) | ((layer_state_t)1 << layer2);
+    layer_state_t mask3  = (layer_state_t)1 << layer3;
+    return (state & mask12) == mask12 ? (state | mask3) : (state & ~mask3);
+}
+
+void default_layer_set(layer_state_t state) {
+    default_layer_state = default_layer_state_set_user(state);
+}
+
+void set_single_persistent_default_layer(uint8_t default_layer) {
+    default_layer_set((layer_state_t)1 << default_layer);
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keymaps[layer][key.row][key.col];
+}
+
+// Highest active layer with a non-transparent key here - default layer included, like QMK
+static uint8_t layer_switch_get_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = HOST_MAX_LAYERS - 1; i >= 0; i--) {
+        if ((layers & ((layer_state_t)1 << i)) && keymap_key_to_keycode(i, key) != KC_TRNS) return i;
+    }
+    return 0;
+}
+
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
+    if (record->keycode) return record->keycode;  // Combo outputs carry their keycode
+
+    keypos_t key = record->event.key;
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return KC_NO;
+
+    uint8_t layer;
+    if (!record->event.pressed) {
+        layer = host_layer_cache[key.row][key.col];  // Release on the layer the press used
+    } else {
+        layer = layer_switch_get_layer(key);
+        if (update_layer_cache) host_layer_cache[key.row][key.col] = layer;
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  MODS AND REPORTS (quantum/action_util.c)                                                          ║
+ * ║  Every report that changes is recorded with its virtual time                                       ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define HOST_REPORTS_MAX 4096
+
+static report_keyboard_t host_keyboard_report;
+static report_nkro_t     host_nkro_report;
+report_keyboard_t       *keyboard_report = &host_keyboard_report;
+report_nkro_t           *nkro_report     = &host_nkro_report;
+keymap_config_t          keymap_config   = {0};
+bool                     debug_enable    = false;
+
+static uint8_t real_mods    = 0;
+static uint8_t weak_mods    = 0;
+static uint8_t oneshot_mods = 0;
+
+static host_report_t host_reports[HOST_REPORTS_MAX];
+static size_t        host_reports_count = 0;
+static host_report_t host_reports_last;
+
+static inline uint8_t mod5_to_mod8(uint8_t mods) {
+    return (mods & 0x10) ? (uint8_t)((mods & 0x0F) << 4) : (uint8_t)(mods & 0x0F);
+}
+
+bool host_report_has(const host_report_t *report, uint8_t code) {
+    return report->bits[code / 8] & (1 << (code % 8));
+}
+
+static bool host_report_any_key(const uint8_t *bits) {
+    for (uint8_t i = 0; i < 32; i++) {
+        if (bits[i]) return true;
+    }
+    return false;
+}
+
+// The report keys go to - the NKRO one while keymap_config.nkro is on, like QMK with an NKRO host
+static uint8_t *host_active_bits(void) {
+    return keymap_config.nkro ? host_nkro_report.bits : host_keyboard_report.bits;
+}
+
+void add_key(uint8_t key) { host_active_bits()[key / 8] |= 1 << (key % 8); }
+void del_key(uint8_t key) { host_active_bits()[key / 8] &= ~(1 << (key % 8)); }
+void clear_keys(void) {
+    memset(host_keyboard_report.bits, 0, sizeof(host_keyboard_report.bits));
+    memset(host_nkro_report.bits, 0, sizeof(host_nkro_report.bits));
+}
+
+void send_keyboard_report(void) {
+    uint8_t  mods = real_mods | weak_mods | oneshot_mods;
+    uint8_t *bits = host_active_bits();
+    if (keymap_config.nkro) {
+        host_nkro_report.mods = mods;
+    } else {
+        host_keyboard_report.mods = mods;
+    }
+    bool key_down = host_report_any_key(bits);
+
+    host_report_t report = {.time = host_ms, .mods = mods};
+    memcpy(report.bits, bits, sizeof(report.bits));
+    if (memcmp(report.bits, host_reports_last.bits, sizeof(report.bits)) || report.mods != host_reports_last.mods) {
+        if (host_reports_count < HOST_REPORTS_MAX) host_reports[host_reports_count++] = report;
+        host_reports_last = report;
+    }
+
+    // One-shot mods apply to the next key only
+    if (oneshot_mods && key_down) oneshot_mods = 0;
+}
+
+void clear_keyboard(void) {
+    real_mods = weak_mods = 0;
+    clear_keys();
+    send_keyboard_report();
+}
+
+uint8_t get_mods(void) { return real_mods; }
+void    add_mods(uint8_t mods) { real_mods |= mods; }
+void    del_mods(uint8_t mods) { real_mods &= ~mods; }
+void    set_mods(uint8_t mods) { real_mods = mods; }
+void    clear_mods(void) { real_mods = 0; }
+
+void register_mods(uint8_t mods) {
+    if (!mods) return;
+    add_mods(mods);
+    send_keyboard_report();
+}
+
+void unregister_mods(uint8_t mods) {
+    if (!mods) return;
+    del_mods(mods);
+    send_keyboard_report();
+}
+
+uint8_t get_oneshot_mods(void) { return oneshot_mods; }
+void    set_oneshot_mods(uint8_t mods) { oneshot_mods = mods; }
+void    add_oneshot_mods(uint8_t mods) { oneshot_mods |= mods; }
+void    del_oneshot_mods(uint8_t mods) { oneshot_mods &= ~mods; }
+void    clear_oneshot_mods(void) { oneshot_mods = 0; }
+
+void register_code(uint8_t code) {
+    if (code == KC_NO) return;
+    if (IS_MODIFIER_KEYCODE(code)) {
+        add_mods(MOD_BIT(code));
+    } else {
+        add_key(code);
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t code) {
+    if (code == KC_NO) return;
+    if (IS_MODIFIER_KEYCODE(code)) {
+        del_mods(MOD_BIT(code));
+    } else {
+        del_key(code);
+    }
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t code) {
+    register_code(code);
+    unregister_code(code);
+}
+
+void register_code16(uint16_t code) {
+    uint8_t mods = mod5_to_mod8(QK_MODS_GET_MODS(code));
+    if (IS_MODIFIER_KEYCODE(code & 0xFF) || (code & 0xFF) == KC_NO) {
+        real_mods |= mods;
+    } else {
+        weak_mods |= mods;
+    }
+    register_code(code & 0xFF);
+    if (!(code & 0xFF)) send_keyboard_report();
+}
+
+void unregister_code16(uint16_t code) {
+    uint8_t mods = mod5_to_mod8(QK_MODS_GET_MODS(code));
+    unregister_code(code & 0xFF);
+    if (IS_MODIFIER_KEYCODE(code & 0xFF) || (code & 0xFF) == KC_NO) {
+        real_mods &= ~mods;
+    } else {
+        weak_mods &= ~mods;
+    }
+    send_keyboard_report();
+}
+
+void tap_code16(uint16_t code) {
+    register_code16(code);
+    unregister_code16(code);
+}
+
+static uint8_t host_ascii_to_keycode(char c, bool *shift) {
+    *shift = false;
+    if (c >= 'a' && c <= 'z') return KC_A + (c - 'a');
+    if (c >= 'A' && c <= 'Z') {
+        *shift = true;
+        return KC_A + (c - 'A');
+    }
+    if (c >= '1' && c <= '9') return KC_1 + (c - '1');
+    switch (c) {
+        case '0': return KC_0;
+        case ' ': return KC_SPC;
+        case '\n': return KC_ENT;
+        case '.': return KC_DOT;
+        case ',': return KC_COMM;
+        case '-': return KC_MINS;
+    }
+    return KC_NO;
+}
+
+void send_string(const char *string) {
+    for (; *string; string++) {
+        bool    shift;
+        uint8_t code = host_ascii_to_keycode(*string, &shift);
+        tap_code16(shift ? LSFT(code) : code);
+    }
+}
+
+size_t               host_report_count(void) { return host_reports_count; }
+const host_report_t *host_report(size_t index) { return index < host_reports_count ? &host_reports[index] : NULL; }
+void                 host_reports_clear(void) { host_reports_count = 0; }
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  DEFAULT ACTIONS (quantum/action.c)                                                                ║
+ * ║  What QMK does with a keycode once process_record_user returns true                                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static void process_action(uint16_t keycode, keyrecord_t *record) {
+    bool pressed = record->event.pressed;
+
+    if (IS_QK_BASIC(keycode)) {
+        if (pressed) register_code(keycode);
+        else         unregister_code(keycode);
+    } else if (IS_QK_MODS(keycode)) {
+        if (pressed) register_code16(keycode);
+        else         unregister_code16(keycode);
+    } else if (IS_QK_MOD_TAP(keycode)) {
+        if (record->tap.count) {
+            if (pressed) register_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+            else         unregister_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+        } else {
+            uint8_t mods = mod5_to_mod8(QK_MOD_TAP_GET_MODS(keycode));
+            if (pressed) register_mods(mods);
+            else         unregister_mods(mods);
+        }
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count) {
+            if (pressed) register_code(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+            else         unregister_code(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+        } else {
+            if (pressed) layer_on(QK_LAYER_TAP_GET_LAYER(keycode));
+            else         layer_off(QK_LAYER_TAP_GET_LAYER(keycode));
+        }
+    } else if (IS_QK_MOMENTARY(keycode)) {
+        if (pressed) layer_on(keycode & 0x1F);
+        else         layer_off(keycode & 0x1F);
+    } else if (IS_QK_TOGGLE_LAYER(keycode)) {
+        if (pressed) layer_invert(keycode & 0x1F);
+    } else if (IS_QK_ONE_SHOT_MOD(keycode)) {
+        if (pressed) add_oneshot_mods(mod5_to_mod8(keycode & 0x1F));
+    }
+    // Tap dance, MIDI, audio, RGB and boot keys have no effect on the host
+}
+
+static void process_record(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+    if (!process_record_user(keycode, record)) return;
+    process_action(keycode, record);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TAP-HOLD ENGINE (quantum/action_tapping.c)                                                        ║
+ * ║  MT()/LT() keys only: per-key term, flow tap, quick tap, chordal hold, permissive hold -           ║
+ * ║  one undecided key at a time, everything pressed behind it waits in order                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define HOST_WAITING_MAX 16
+
+typedef struct {
+    keypos_t key;
+    uint8_t  tap_count;  // Tap count its release carries
+    bool     used;
+} host_settled_t;
+
+static keyrecord_t    tapping_key;                       // Undecided tap-hold key
+static bool           tapping_active = false;
+static keyrecord_t    waiting_buffer[HOST_WAITING_MAX];  // Events queued behind it
+static uint8_t        waiting_count = 0;
+static host_settled_t settled[8];                        // Decided tap-hold keys still down
+
+static uint16_t flow_prev_keycode = KC_NO;
+static uint16_t flow_prev_time    = 0;
+static keypos_t quick_tap_key     = {.row = 255, .col = 255};
+static uint16_t quick_tap_time    = 0;
+
+static void tapping_dispatch(keyrecord_t record);
+
+static bool is_tap_hold_keycode(uint16_t keycode) {
+    return IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+}
+
+static host_settled_t *settled_find(keypos_t key) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(settled); i++) {
+        if (settled[i].used && KEYEQ(settled[i].key, key)) return &settled[i];
+    }
+    return NULL;
+}
+
+static void settled_add(keypos_t key, uint8_t tap_count) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(settled); i++) {
+        if (!settled[i].used) {
+            settled[i] = (host_settled_t){key, tap_count, true};
+            return;
+        }
+    }
+}
+
+__attribute__((weak)) bool is_flow_tap_key(uint16_t keycode) {
+    if (get_mods() & (MOD_MASK_CG | MOD_BIT_LALT)) return false;
+    if (IS_QK_MOD_TAP(keycode)) keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    if (IS_QK_LAYER_TAP(keycode)) keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    switch (keycode) {
+        case KC_SPC:
+        case KC_A ... KC_Z:
+        case KC_DOT:
+        case KC_COMM:
+        case KC_SCLN:
+        case KC_SLSH:
+            return true;
+    }
+    return false;
+}
+
+__attribute__((weak)) uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) { return TAPPING_TERM; }
+__attribute__((weak)) uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record) { return QUICK_TAP_TERM; }
+__attribute__((weak)) bool get_permissive_hold(uint16_t keycode, keyrecord_t *record) { return false; }
+__attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record) { return false; }
+__attribute__((weak)) uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    return is_flow_tap_key(keycode) && is_flow_tap_key(prev_keycode) ? FLOW_TAP_TERM : 0;
+}
+
+__attribute__((weak)) const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS];
+
+bool get_chordal_hold_default(keyrecord_t *tap_hold_record, keyrecord_t *other_record) {
+    if (tap_hold_record->event.type != KEY_EVENT || other_record->event.type != KEY_EVENT) return true;
+    char tap_hold_hand = chordal_hold_layout[tap_hold_record->event.key.row][tap_hold_record->event.key.col];
+    if (tap_hold_hand == '*') return true;
+    char other_hand = chordal_hold_layout[other_record->event.key.row][other_record->event.key.col];
+    return other_hand == '*' || tap_hold_hand != other_hand;
+}
+
+__attribute__((weak)) bool get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record,
+                                            uint16_t other_keycode, keyrecord_t *other_record) {
+    return get_chordal_hold_default(tap_hold_record, other_record);
+}
+
+static uint16_t tapping_keycode(void) { return get_record_keycode(&tapping_key, false); }
+
+// The undecided key is settled - process it, then everything that queued behind it, in order
+static void tapping_settle(uint8_t tap_count) {
+    keyrecord_t key = tapping_key;
+    tapping_active  = false;
+
+    key.tap.count = tap_count;
+    settled_add(key.event.key, tap_count);
+    process_record(&key);
+
+    keyrecord_t queued[HOST_WAITING_MAX];
+    uint8_t     count = waiting_count;
+    memcpy(queued, waiting_buffer, count * sizeof(keyrecord_t));
+    waiting_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        queued[i].tap.interrupted = false;
+        tapping_dispatch(queued[i]);
+    }
+}
+
+static bool waiting_has_press(keypos_t key) {
+    for (uint8_t i = 0; i < waiting_count; i++) {
+        if (waiting_buffer[i].event.pressed && KEYEQ(waiting_buffer[i].event.key, key)) return true;
+    }
+    return false;
+}
+
+static void waiting_enqueue(keyrecord_t record) {
+    if (waiting_count >= HOST_WAITING_MAX) {
+        tapping_settle(0);  // Overflow: QMK clears the buffer, settling as a hold is the gentler host model
+        tapping_dispatch(record);
+        return;
+    }
+    waiting_buffer[waiting_count++] = record;
+}
+
+// An event while a tap-hold key is undecided
+static void tapping_undecided(keyrecord_t record) {
+    uint16_t term = get_tapping_term(tapping_keycode(), &tapping_key);
+    if (TIMER_DIFF_16(record.event.time, tapping_key.event.time) >= term) {
+        tapping_settle(0);  // Term ran out before this event
+        tapping_dispatch(record);
+        return;
+    }
+    if (record.event.type == TICK_EVENT) return;
+
+    bool     is_tapping_key = record.event.type == KEY_EVENT && KEYEQ(record.event.key, tapping_key.event.key);
+    uint16_t keycode        = get_record_keycode(&record, false);
+
+    if (is_tapping_key && !record.event.pressed) {
+        tapping_settle(1);  // Released within the term: tap
+        quick_tap_key  = record.event.key;
+        quick_tap_time = record.event.time;
+        tapping_dispatch(record);
+        return;
+    }
+
+    if (record.event.pressed) {
+        if (!get_chordal_hold(tapping_keycode(), &tapping_key, keycode, &record)) {
+            tapping_settle(1);  // Same-hand key: settled as tapped
+            tapping_dispatch(record);
+            return;
+        }
+        if (get_hold_on_other_key_press(tapping_keycode(), &tapping_key)) {
+            tapping_settle(0);
+            tapping_dispatch(record);
+            return;
+        }
+        record.tap.interrupted = true;
+        waiting_enqueue(record);
+        return;
+    }
+
+    // Release of another key
+    if (!waiting_has_press(record.event.key)) {
+        process_record(&record);  // Pressed before the tap-hold key - not held back
+        return;
+    }
+    if (get_permissive_hold(tapping_keycode(), &tapping_key)) {
+        tapping_settle(0);  // Nested tap: hold
+        tapping_dispatch(record);
+        return;
+    }
+    waiting_enqueue(record);
+}
+
+static void tapping_dispatch(keyrecord_t record) {
+    if (tapping_active) {
+        tapping_undecided(record);
+        return;
+    }
+    if (record.event.type == TICK_EVENT) return;
+
+    if (!record.event.pressed) {
+        host_settled_t *key = record.event.type == KEY_EVENT ? settled_find(record.event.key) : NULL;
+        if (key) {
+            record.tap.count = key->tap_count;
+            key->used        = false;
+        }
+        process_record(&record);
+        return;
+    }
+
+    uint16_t keycode = get_record_keycode(&record, false);
+    if (!is_tap_hold_keycode(keycode) || record.event.type != KEY_EVENT) {
+        process_record(&record);
+        return;
+    }
+
+    // Quick tap: re-pressed right after its own tap → tap again
+    if (KEYEQ(record.event.key, quick_tap_key) &&
+        TIMER_DIFF_16(record.event.time, quick_tap_time) < get_quick_tap_term(keycode, &record)) {
+        record.tap.count = 2;
+        settled_add(record.event.key, 2);
+        process_record(&record);
+        return;
+    }
+
+    // Flow tap: pressed mid-streak → tap at press time
+    uint16_t flow_term = get_flow_tap_term(keycode, &record, flow_prev_keycode);
+    if (flow_term && TIMER_DIFF_16(record.event.time, flow_prev_time) < flow_term) {
+        record.tap.count = 1;
+        settled_add(record.event.key, 1);
+        process_record(&record);
+        return;
+    }
+
+    tapping_key    = record;
+    tapping_active = true;
+}
+
+void action_tapping_process(keyrecord_t record) {
+    tapping_dispatch(record);
+    if (record.event.type != TICK_EVENT && record.event.pressed) {
+        flow_prev_keycode = get_record_keycode(&record, false);  // After dispatch - a key isn't its own predecessor
+        flow_prev_time    = record.event.time;
+    }
+}
+
+void action_exec(keyevent_t event) {
+    keyrecord_t record = {.event = event};
+    if (event.type != TICK_EVENT) {
+        if (!pre_process_record_user(get_record_keycode(&record, true), &record)) return;
+    }
+    action_tapping_process(record);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  WEAK USER HOOKS                                                                                   ║
+ * ║  Benchmarks link the stub without a keymap                                                         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+__attribute__((weak)) const uint16_t keymaps[1][MATRIX_ROWS][MATRIX_COLS];
+
+__attribute__((weak)) bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) { return true; }
+__attribute__((weak)) bool process_record_user(uint16_t keycode, keyrecord_t *record) { return true; }
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) { return state; }
+__attribute__((weak)) layer_state_t default_layer_state_set_user(layer_state_t state) { return state; }
+__attribute__((weak)) void keyboard_post_init_user(void) {}
+__attribute__((weak)) void housekeeping_task_user(void) {}
+__attribute__((weak)) void matrix_scan_user(void) {}
+__attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EEPROM, CONSOLE, RAW HID, MIDI                                                                    ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+static uint32_t host_eeconfig_user = 0;
+
+uint32_t eeconfig_read_user(void) { return host_eeconfig_user; }
+void     eeconfig_update_user(uint32_t value) { host_eeconfig_user = value; }
+
+static char  *host_console_buf = NULL;
+static size_t host_console_len = 0, host_console_cap = 0;
+
+int uprintf(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+    if (len <= 0) return len;
+
+    if (host_console_len + len + 1 > host_console_cap) {
+        host_console_cap = (host_console_len + len + 1) * 2;
+        host_console_buf = realloc(host_console_buf, host_console_cap);
+    }
+    va_start(args, fmt);
+    vsnprintf(host_console_buf + host_console_len, len + 1, fmt, args);
+    va_end(args);
+    host_console_len += len;
+    return len;
+}
+
+const char *host_console(void) { return host_console_buf ? host_console_buf : ""; }
+void        host_console_clear(void) {
+    host_console_len = 0;
+    if (host_console_buf) host_console_buf[0] = '\0';
+}
+
+void raw_hid_send(uint8_t *data, uint8_t length) {}
+
+MidiDevice    midi_device;
+midi_config_t midi_config;
+
+static uint32_t host_midi_count = 0;
+
+void     midi_send_cc(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t val) { host_midi_count++; }
+void     midi_send_noteon(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t vel) { host_midi_count++; }
+void     midi_send_noteoff(MidiDevice *device, uint8_t chan, uint8_t num, uint8_t vel) { host_midi_count++; }
+void     midi_send_programchange(MidiDevice *device, uint8_t chan, uint8_t num) { host_midi_count++; }
+uint32_t host_midi_messages(void) { return host_midi_count; }
+
+#ifdef UNICODE_COMMON_ENABLE
+void register_unicode(uint32_t code_point) { uprintf("U+%04X\n", (unsigned)code_point); }
+void set_unicode_input_mode(uint8_t mode) {}
+#endif
+
+#ifdef MIDI_ENABLE
+void midi_on(void) {}
+void midi_off(void) {}
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  RGB MATRIX                                                                                        ║
+ * ║  One frame = clear, then the indicator hook - what the LEDs show over an all-black effect          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifdef RGB_MATRIX_ENABLE
+// clang-format off
+led_config_t g_led_config = {{
+    {6, 6, 6, 5, 5, 5}, {6, 6, 6, 5, 5, 5}, {7, 7, 7, 0, 0, 0}, {7, 7, 7, 0, 0, 0},
+    {4, 4, 4, 3, 3, 3}, {4, 4, 4, 3, 3, 3}, {8, 8, 8, 2, 2, 2}, {1, 1, 1, 2, 2, 2},
+}};
+// clang-format on
+
+static RGB  host_leds[RGB_MATRIX_LED_COUNT];
+static bool host_rgb_enabled = true;
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) host_leds[index] = (RGB){red, green, blue};
+}
+
+RGB hsv_to_rgb(HSV hsv) {
+    if (!hsv.s) return (RGB){hsv.v, hsv.v, hsv.v};
+    uint8_t region = hsv.h / 43, rem = (hsv.h - region * 43) * 6;
+    uint8_t p = (hsv.v * (255 - hsv.s)) >> 8;
+    uint8_t q = (hsv.v * (255 - ((hsv.s * rem) >> 8))) >> 8;
+    uint8_t t = (hsv.v * (255 - ((hsv.s * (255 - rem)) >> 8))) >> 8;
+    switch (region) {
+        case 0: return (RGB){hsv.v, t, p};
+        case 1: return (RGB){q, hsv.v, p};
+        case 2: return (RGB){p, hsv.v, t};
+        case 3: return (RGB){p, q, hsv.v};
+        case 4: return (RGB){t, p, hsv.v};
+        default: return (RGB){hsv.v, p, q};
+    }
+}
+
+bool rgb_matrix_is_enabled(void) { return host_rgb_enabled; }
+void rgb_matrix_enable_noeeprom(void) { host_rgb_enabled = true; }
+void rgb_matrix_disable_noeeprom(void) { host_rgb_enabled = false; }
+
+__attribute__((weak)) bool rgb_matrix_indicators_user(void) { return true; }
+
+void host_rgb_frame(void) {
+    memset(host_leds, 0, sizeof(host_leds));
+    if (host_rgb_enabled) rgb_matrix_indicators_user();  // QMK skips the whole task while disabled
+}
+
+RGB host_rgb_led(uint8_t index) { return index < RGB_MATRIX_LED_COUNT ? host_leds[index] : (RGB){0, 0, 0}; }
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  HARNESS CONTROL                                                                                   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+keypos_t host_grid_key(uint8_t grid) {
+    uint8_t row = grid / 12, col = grid % 12;
+    return col < MATRIX_COLS ? (keypos_t){.col = col, .row = row}
+                             : (keypos_t){.col = col - MATRIX_COLS, .row = row + MATRIX_ROWS / 2};
+}
+
+int host_grid_of(uint8_t layer, uint16_t keycode) {
+    for (uint8_t grid = 0; grid < GRID_KEYS; grid++) {
+        if (keymap_key_to_keycode(layer, host_grid_key(grid)) == keycode) return grid;
+    }
+    return -1;
+}
+
+void host_init(void) {
+    default_layer_set(1);
+    keyboard_post_init_user();
+    housekeeping_task_user();
+}
+
+void host_key(uint8_t grid, bool pressed) {
+    keypos_t key = host_grid_key(grid);
+    host_last_input = host_ms;
+    host_scan_event = true;
+    action_exec(MAKE_KEYEVENT(key.row, key.col, pressed));
+}
+
+void host_scan(void) {
+    matrix_scan_user();
+    if (!host_scan_event) {
+        action_exec((keyevent_t){.type = TICK_EVENT, .time = timer_read()});
+    }
+    deferred_exec_task();
+    housekeeping_task_user();
+    host_scan_event = false;
+    host_ms++;
+}
+
+void host_idle(uint32_t ms) {
+    while (ms--) host_scan();
+}
@@ -0,0 +1,552 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST QMK STUB
+ * The slice of the QMK API this keymap uses, built for the host - stands in for QMK_KEYBOARD_H
+ * Keycode values, types and hook order follow QMK; behaviour lives in qmk_stub.c
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "print.h"  // quantum.h pulls the console in for every keymap
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  PLATFORM                                                                                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define PROGMEM
+#define pgm_read_byte(p)        (*(const uint8_t *)(p))
+#define pgm_read_word(p)        (*(const uint16_t *)(p))
+#define memcpy_P(dst, src, n)   memcpy((dst), (src), (n))
+#define ARRAY_SIZE(a)           (sizeof(a) / sizeof((a)[0]))
+#ifndef MIN
+#    define MIN(a, b)           ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#    define MAX(a, b)           ((a) > (b) ? (a) : (b))
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  MATRIX (PLANCK REV7)                                                                              ║
+ * ║  Grid row r, column c → matrix [r][c] on the left half, [r + 4][c - 6] on the right                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+#define GRID_KEYS   48
+
+// clang-format off
+#define LAYOUT_planck_grid(                                                   \
+    k00, k01, k02, k03, k04, k05, k06, k07, k08, k09, k0a, k0b,               \
+    k10, k11, k12, k13, k14, k15, k16, k17, k18, k19, k1a, k1b,               \
+    k20, k21, k22, k23, k24, k25, k26, k27, k28, k29, k2a, k2b,               \
+    k30, k31, k32, k33, k34, k35, k36, k37, k38, k39, k3a, k3b)               \
+    {                                                                         \
+        {k00, k01, k02, k03, k04, k05}, {k10, k11, k12, k13, k14, k15},       \
+        {k20, k21, k22, k23, k24, k25}, {k30, k31, k32, k33, k34, k35},       \
+        {k06, k07, k08, k09, k0a, k0b}, {k16, k17, k18, k19, k1a, k1b},       \
+        {k26, k27, k28, k29, k2a, k2b}, {k36, k37, k38, k39, k3a, k3b},       \
+    }
+// clang-format on
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  KEYCODES                                                                                          ║
+ * ║  Same values as quantum/keycodes.h                                                                 ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+enum qk_basic_keycodes {
+    KC_NO = 0x0000, KC_TRNS = 0x0001,
+    KC_A = 0x04, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1 = 0x1E, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENT = 0x28, KC_ESC, KC_BSPC, KC_TAB, KC_SPC, KC_MINS, KC_EQL, KC_LBRC, KC_RBRC, KC_BSLS,
+    KC_NUHS, KC_SCLN, KC_QUOT, KC_GRV, KC_COMM, KC_DOT, KC_SLSH, KC_CAPS,
+    KC_F1 = 0x3A, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_PSCR = 0x46, KC_SCRL, KC_PAUS, KC_INS, KC_HOME, KC_PGUP, KC_DEL, KC_END, KC_PGDN,
+    KC_RGHT, KC_LEFT, KC_DOWN, KC_UP,
+    KC_CNCL = 0x9B,
+    KC_MUTE = 0xA8, KC_VOLU, KC_VOLD, KC_MNXT, KC_MPRV, KC_MSTP, KC_MPLY,
+    MS_UP = 0xCD, MS_DOWN, MS_LEFT, MS_RGHT,
+    MS_BTN1 = 0xD1, MS_BTN2, MS_BTN3, MS_BTN4, MS_BTN5, MS_BTN6, MS_BTN7, MS_BTN8,
+    MS_WHLU = 0xD9, MS_WHLD, MS_WHLL, MS_WHLR,
+    KC_LCTL = 0xE0, KC_LSFT, KC_LALT, KC_LGUI, KC_RCTL, KC_RSFT, KC_RALT, KC_RGUI,
+};
+
+#define _______ KC_TRNS
+#define XXXXXXX KC_NO
+#define KC_TRANSPARENT KC_TRNS
+#define KC_GRAVE KC_GRV
+#define KC_RIGHT KC_RGHT
+#define KC_ENTER KC_ENT
+#define KC_ESCAPE KC_ESC
+#define KC_SPACE KC_SPC
+
+// Ranges
+#define QK_BASIC            0x0000
+#define QK_BASIC_MAX        0x00FF
+#define QK_MODS             0x0100
+#define QK_MODS_MAX         0x1FFF
+#define QK_MOD_TAP          0x2000
+#define QK_MOD_TAP_MAX      0x3FFF
+#define QK_LAYER_TAP        0x4000
+#define QK_LAYER_TAP_MAX    0x4FFF
+#define QK_MOMENTARY        0x5220
+#define QK_MOMENTARY_MAX    0x523F
+#define QK_DEF_LAYER        0x5240
+#define QK_TOGGLE_LAYER     0x5260
+#define QK_TOGGLE_LAYER_MAX 0x527F
+#define QK_ONE_SHOT_MOD     0x52A0
+#define QK_ONE_SHOT_MOD_MAX 0x52BF
+#define QK_TAP_DANCE        0x5700
+#define QK_TAP_DANCE_MAX    0x57FF
+#define QK_MIDI             0x7100
+#define QK_MIDI_MAX         0x71FF
+#define QK_USER             0x7E40
+#define SAFE_RANGE          QK_USER
+
+#define IS_QK_BASIC(kc)        ((kc) <= QK_BASIC_MAX)
+#define IS_QK_MODS(kc)         ((kc) >= QK_MODS && (kc) <= QK_MODS_MAX)
+#define IS_QK_MOD_TAP(kc)      ((kc) >= QK_MOD_TAP && (kc) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(kc)    ((kc) >= QK_LAYER_TAP && (kc) <= QK_LAYER_TAP_MAX)
+#define IS_QK_MOMENTARY(kc)    ((kc) >= QK_MOMENTARY && (kc) <= QK_MOMENTARY_MAX)
+#define IS_QK_TOGGLE_LAYER(kc) ((kc) >= QK_TOGGLE_LAYER && (kc) <= QK_TOGGLE_LAYER_MAX)
+#define IS_QK_ONE_SHOT_MOD(kc) ((kc) >= QK_ONE_SHOT_MOD && (kc) <= QK_ONE_SHOT_MOD_MAX)
+#define IS_QK_TAP_DANCE(kc)    ((kc) >= QK_TAP_DANCE && (kc) <= QK_TAP_DANCE_MAX)
+#define IS_QK_MIDI(kc)         ((kc) >= QK_MIDI && (kc) <= QK_MIDI_MAX)
+#define IS_MODIFIER_KEYCODE(kc) ((kc) >= KC_LCTL && (kc) <= KC_RGUI)
+
+// Mod bits (5-bit packed in keycodes, 8-bit in reports)
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RCTL 0x11
+#define MOD_RSFT 0x12
+#define MOD_RALT 0x14
+#define MOD_RGUI 0x18
+
+#define MOD_BIT(code)    (1 << ((code) & 0x07))
+#define MOD_MASK_CTRL    (MOD_BIT(KC_LCTL) | MOD_BIT(KC_RCTL))
+#define MOD_MASK_SHIFT   (MOD_BIT(KC_LSFT) | MOD_BIT(KC_RSFT))
+#define MOD_MASK_ALT     (MOD_BIT(KC_LALT) | MOD_BIT(KC_RALT))
+#define MOD_MASK_GUI     (MOD_BIT(KC_LGUI) | MOD_BIT(KC_RGUI))
+#define MOD_MASK_CS      (MOD_MASK_CTRL | MOD_MASK_SHIFT)
+#define MOD_MASK_CG      (MOD_MASK_CTRL | MOD_MASK_GUI)
+#define MOD_BIT_LALT     MOD_BIT(KC_LALT)
+
+// Modded keycodes
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define QK_RMODS_MIN 0x1000
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define C(kc)    LCTL(kc)
+#define S(kc)    LSFT(kc)
+#define A(kc)    LALT(kc)
+#define G(kc)    LGUI(kc)
+#define SGUI(kc) (QK_LGUI | QK_LSFT | (kc))
+#define HYPR(kc) (QK_LCTL | QK_LSFT | QK_LALT | QK_LGUI | (kc))
+
+#define QK_MODS_GET_MODS(kc)          (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+
+#define KC_EXLM LSFT(KC_1)
+#define KC_AT   LSFT(KC_2)
+#define KC_HASH LSFT(KC_3)
+#define KC_DLR  LSFT(KC_4)
+#define KC_PERC LSFT(KC_5)
+#define KC_CIRC LSFT(KC_6)
+#define KC_AMPR LSFT(KC_7)
+#define KC_ASTR LSFT(KC_8)
+#define KC_LPRN LSFT(KC_9)
+#define KC_RPRN LSFT(KC_0)
+#define KC_UNDS LSFT(KC_MINS)
+#define KC_PLUS LSFT(KC_EQL)
+#define KC_LCBR LSFT(KC_LBRC)
+#define KC_RCBR LSFT(KC_RBRC)
+#define KC_PIPE LSFT(KC_BSLS)
+#define KC_TILD LSFT(KC_GRV)
+#define KC_COLN LSFT(KC_SCLN)
+#define KC_LT   LSFT(KC_COMM)
+#define KC_GT   LSFT(KC_DOT)
+#define KC_QUES LSFT(KC_SLSH)
+
+// Mod-tap, layer-tap, layer keys
+#define MT(mod, kc) (QK_MOD_TAP | (((mod) & 0x1F) << 8) | ((kc) & 0xFF))
+#define LCTL_T(kc)  MT(MOD_LCTL, kc)
+#define LSFT_T(kc)  MT(MOD_LSFT, kc)
+#define LALT_T(kc)  MT(MOD_LALT, kc)
+#define LGUI_T(kc)  MT(MOD_LGUI, kc)
+#define RCTL_T(kc)  MT(MOD_RCTL, kc)
+#define RSFT_T(kc)  MT(MOD_RSFT, kc)
+#define RALT_T(kc)  MT(MOD_RALT, kc)
+#define RGUI_T(kc)  MT(MOD_RGUI, kc)
+#define QK_MOD_TAP_GET_MODS(kc)        (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define QK_LAYER_TAP_GET_LAYER(kc)       (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+
+#define MO(layer)  (QK_MOMENTARY | ((layer) & 0x1F))
+#define TG(layer)  (QK_TOGGLE_LAYER | ((layer) & 0x1F))
+#define OSM(mod)   (QK_ONE_SHOT_MOD | ((mod) & 0x1F))
+#define TD(index)  (QK_TAP_DANCE | ((index) & 0xFF))
+
+// Quantum keycodes - only distinct values matter here
+enum qk_quantum_keycodes {
+    QK_BOOT = 0x7C00, QK_DEBUG_TOGGLE = 0x7C02, QK_CLEAR_EEPROM = 0x7C03,
+    AU_ON = 0x7480, AU_OFF, AU_TOGG, AU_NEXT = 0x7490, AU_PREV,
+    MU_ON = 0x7484, MU_OFF, MU_TOGG,
+    RM_ON = 0x7840, RM_OFF, RM_TOGG, RM_NEXT, RM_PREV, RM_HUEU, RM_HUED, RM_SATU, RM_SATD,
+    RM_VALU, RM_VALD,
+    MI_ON = QK_MIDI, MI_OFF, MI_TOGG,
+    MI_C = QK_MIDI + 0x03, MI_Cs, MI_D, MI_Ds, MI_E, MI_F, MI_Fs, MI_G, MI_Gs, MI_A, MI_As, MI_B,
+};
+#define EE_CLR  QK_CLEAR_EEPROM
+#define DB_TOGG QK_DEBUG_TOGGLE
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EVENTS AND RECORDS                                                                                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+enum keyevent_type { TICK_EVENT = 0, KEY_EVENT = 1, ENCODER_CW_EVENT, ENCODER_CCW_EVENT, COMBO_EVENT, DIP_SWITCH_ON_EVENT };
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    bool    reserved2 : 1;
+    bool    reserved1 : 1;
+    bool    reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+    uint16_t   keycode;
+} keyrecord_t;
+
+#define KEYLOC_COMBO 254
+#define KEYEQ(a, b)  ((a).row == (b).row && (a).col == (b).col)
+#define MAKE_KEYEVENT(row_num, col_num, press) \
+    ((keyevent_t){.key = (keypos_t){.col = (col_num), .row = (row_num)}, .pressed = (press), .time = timer_read(), .type = KEY_EVENT})
+#define MAKE_COMBOEVENT(press) \
+    ((keyevent_t){.key = (keypos_t){.col = KEYLOC_COMBO, .row = KEYLOC_COMBO}, .pressed = (press), .time = timer_read(), .type = COMBO_EVENT})
+
+void action_exec(keyevent_t event);
+void action_tapping_process(keyrecord_t record);
+uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TIMER - VIRTUAL CLOCK                                                                             ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+uint32_t last_input_activity_elapsed(void);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  DEFERRED EXECUTION                                                                                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+typedef uint8_t deferred_token;
+typedef uint32_t (*deferred_exec_callback)(uint32_t trigger_time, void *cb_arg);
+#define INVALID_DEFERRED_TOKEN 0
+
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg);
+bool           cancel_deferred_exec(deferred_token token);
+bool           extend_deferred_exec(deferred_token token, uint32_t delay_ms);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  LAYERS                                                                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifdef LAYER_STATE_8BIT
+typedef uint8_t layer_state_t;
+#else
+typedef uint16_t layer_state_t;
+#endif
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+uint8_t       get_highest_layer(layer_state_t state);
+bool          layer_state_is(uint8_t layer);
+bool          layer_state_cmp(layer_state_t state, uint8_t layer);
+void          layer_state_set(layer_state_t state);
+void          layer_on(uint8_t layer);
+void          layer_off(uint8_t layer);
+void          layer_invert(uint8_t layer);
+void          layer_move(uint8_t layer);
+void          layer_clear(void);
+layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_t layer2, uint8_t layer3);
+void          default_layer_set(layer_state_t state);
+void          set_single_persistent_default_layer(uint8_t default_layer);
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  KEYBOARD REPORT AND MODS                                                                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t bits[32];  // NKRO-style bitmap, one bit per basic keycode
+} report_keyboard_t;
+
+extern report_keyboard_t *keyboard_report;
+
+// Keys go here instead while keymap_config.nkro is on - mods too
+typedef struct {
+    uint8_t report_id;
+    uint8_t mods;
+    uint8_t bits[32];
+} report_nkro_t;
+
+extern report_nkro_t *nkro_report;
+
+typedef union {
+    uint16_t raw;
+    struct {
+        bool swap_control_capslock : 1;
+        bool capslock_to_control : 1;
+        bool swap_lalt_lgui : 1;
+        bool swap_ralt_rgui : 1;
+        bool no_gui : 1;
+        bool swap_grave_esc : 1;
+        bool swap_backslash_backspace : 1;
+        bool nkro : 1;
+    };
+} keymap_config_t;
+
+extern keymap_config_t keymap_config;
+extern bool            debug_enable;
+
+void add_key(uint8_t key);
+void del_key(uint8_t key);
+void clear_keys(void);
+void send_keyboard_report(void);
+void clear_keyboard(void);
+
+void register_code(uint8_t code);
+void unregister_code(uint8_t code);
+void tap_code(uint8_t code);
+void register_code16(uint16_t code);
+void unregister_code16(uint16_t code);
+void tap_code16(uint16_t code);
+void send_string(const char *string);
+#define SEND_STRING(string) send_string(string)
+
+uint8_t get_mods(void);
+void    add_mods(uint8_t mods);
+void    del_mods(uint8_t mods);
+void    set_mods(uint8_t mods);
+void    clear_mods(void);
+void    register_mods(uint8_t mods);
+void    unregister_mods(uint8_t mods);
+uint8_t get_oneshot_mods(void);
+void    set_oneshot_mods(uint8_t mods);
+void    add_oneshot_mods(uint8_t mods);
+void    del_oneshot_mods(uint8_t mods);
+void    clear_oneshot_mods(void);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TAPPING (action_tapping.c)                                                                        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
+uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record);
+bool     get_permissive_hold(uint16_t keycode, keyrecord_t *record);
+bool     get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record);
+bool     get_chordal_hold(uint16_t tap_hold_keycode, keyrecord_t *tap_hold_record, uint16_t other_keycode,
+                          keyrecord_t *other_record);
+bool     get_chordal_hold_default(keyrecord_t *tap_hold_record, keyrecord_t *other_record);
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode);
+bool     is_flow_tap_key(uint16_t keycode);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  USER HOOKS                                                                                        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+bool          pre_process_record_user(uint16_t keycode, keyrecord_t *record);
+bool          process_record_user(uint16_t keycode, keyrecord_t *record);
+layer_state_t layer_state_set_user(layer_state_t state);
+layer_state_t default_layer_state_set_user(layer_state_t state);
+void          keyboard_post_init_user(void);
+void          housekeeping_task_user(void);
+void          matrix_scan_user(void);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  EEPROM                                                                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+uint32_t eeconfig_read_user(void);
+void     eeconfig_update_user(uint32_t value);
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  RGB MATRIX                                                                                        ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define NO_LED 255
+
+#ifdef RGB_MATRIX_ENABLE
+#    define RGB_MATRIX_LED_COUNT 9
+
+typedef struct {
+    uint8_t r, g, b;
+} RGB;
+typedef struct {
+    uint8_t h, s, v;
+} HSV;
+
+typedef struct {
+    uint8_t matrix_co[MATRIX_ROWS][MATRIX_COLS];
+} led_config_t;
+
+extern led_config_t g_led_config;
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+RGB  hsv_to_rgb(HSV hsv);
+bool rgb_matrix_is_enabled(void);
+void rgb_matrix_enable_noeeprom(void);
+void rgb_matrix_disable_noeeprom(void);
+bool rgb_matrix_indicators_user(void);
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  FEATURES OFF IN THE HOST BUILD                                                                    ║
+ * ║  Declarations only, gated like quantum.h - enough to compile every build profile                   ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifdef AUDIO_ENABLE
+#    include "musical_notes.h"
+#    define PLAY_SONG(note_array) audio_play_melody(&note_array, ARRAY_SIZE(note_array), false)
+void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
+bool is_music_on(void);
+void music_on(void);
+void music_off(void);
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+typedef struct {
+    uint16_t      trigger;
+    uint8_t       trigger_mods;
+    layer_state_t layers;
+    uint8_t       negative_mod_mask;
+    uint8_t       suppressed_mods;
+    uint16_t      replacement;
+    uint8_t       options;
+    void         *context;
+    bool         *enabled;
+} key_override_t;
+
+#    define ko_make_with_layers_and_negmods(trigger_mods_, trigger_key, replacement_key, layer_mask, negative_mask) \
+        ((const key_override_t){.trigger_mods = (trigger_mods_), .layers = (layer_mask),                            \
+                                .suppressed_mods = (trigger_mods_), .options = 0, .negative_mod_mask = (negative_mask), \
+                                .trigger = (trigger_key), .replacement = (replacement_key), .enabled = NULL})
+#    define ko_make_basic(trigger_mods, trigger_key, replacement_key) \
+        ko_make_with_layers_and_negmods(trigger_mods, trigger_key, replacement_key, ~0, 0)
+
+bool key_override_is_enabled(void);
+void key_override_on(void);
+void key_override_off(void);
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+typedef struct {
+    uint16_t kc1, kc2;
+} tap_dance_pair_t;
+typedef struct {
+    tap_dance_pair_t pair;
+} tap_dance_action_t;
+#    define ACTION_TAP_DANCE_DOUBLE(kc1, kc2) {.pair = {kc1, kc2}}
+#endif
+
+#ifdef UNICODE_COMMON_ENABLE
+enum unicode_input_modes {
+    UNICODE_MODE_MACOS,
+    UNICODE_MODE_LINUX,
+    UNICODE_MODE_WINDOWS,
+    UNICODE_MODE_BSD,
+    UNICODE_MODE_WINCOMPOSE,
+    UNICODE_MODE_EMACS,
+    UNICODE_MODE_COUNT
+};
+void register_unicode(uint32_t code_point);
+void set_unicode_input_mode(uint8_t mode);
+#endif
+
+#ifdef MIDI_ENABLE
+void midi_on(void);
+void midi_off(void);
+#endif
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  HARNESS CONTROL                                                                                   ║
+ * ║  Not QMK - how tests, benchmarks and replay_host drive the stub                                    ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+typedef struct {
+    uint32_t time;   // Virtual ms the report went out
+    uint8_t  mods;   // Real, weak and one-shot mods as sent
+    uint8_t  bits[32];
+} host_report_t;
+
+void     host_init(void);                       // Boot: keyboard_post_init_user, default layer 0
+void     host_key(uint8_t grid, bool pressed);  // Matrix edge on a LAYOUT_planck_grid position, this ms
+void     host_scan(void);                       // One scan loop: ticks, deferred exec, housekeeping, +1 ms
+void     host_idle(uint32_t ms);                // host_scan() ms times
+uint32_t host_now(void);                        // Virtual ms
+
+keypos_t host_grid_key(uint8_t grid);                  // LAYOUT_planck_grid position → matrix
+int      host_grid_of(uint8_t layer, uint16_t keycode); // First position of a keycode on a layer, -1 if none
+
+size_t               host_report_count(void);
+const host_report_t *host_report(size_t index);
+void                 host_reports_clear(void);
+bool                 host_report_has(const host_report_t *report, uint8_t code);
+
+const char *host_console(void);  // Everything uprintf'd so far
+void        host_console_clear(void);
+
+#ifdef RGB_MATRIX_ENABLE
+void host_rgb_frame(void);                  // One RGB frame: clear, then rgb_matrix_indicators_user if enabled
+RGB  host_rgb_led(uint8_t index);           // Colour set during the last frame (0,0,0 = untouched)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
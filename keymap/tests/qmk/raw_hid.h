@@ -0,0 +1,20 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * HOST STUB - raw_hid.h
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void raw_hid_send(uint8_t *data, uint8_t length);
+void raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * TYPING REPLAY DRIVER
+ * Plays a keystroke log through the host-built keymap on the virtual clock and prints every key the
+ * host sees go down - replay.py builds one per timing configuration and scores the output
+ *   replay_host < log.csv    (ms,pos,down per line → ms,code,mods per line)
+ */
+
+#include QMK_KEYBOARD_H
+#include <stdio.h>
+
+static host_report_t replay_last;  // Previous report - only new key-downs are printed
+static bool          replay_down[GRID_KEYS];
+
+// Print and drop what the stub recorded since the last call - the log can outgrow its report buffer
+static void replay_flush(long offset) {
+    for (size_t i = 0; i < host_report_count(); i++) {
+        const host_report_t *report = host_report(i);
+        for (uint16_t code = 1; code <= 0xFF; code++) {
+            if (host_report_has(report, code) && !host_report_has(&replay_last, code)) {
+                printf("%ld,%u,%u\n", (long)report->time + offset, code, report->mods);
+            }
+        }
+        replay_last = *report;
+    }
+    host_reports_clear();
+}
+
+int main(void) {
+    host_init();
+    host_idle(1000);  // Boot settles, nothing typed for a while
+    host_reports_clear();
+
+    char line[64];
+    long offset = 0;  // Log ms - virtual ms
+    bool started = false;
+    while (fgets(line, sizeof(line), stdin)) {
+        long ms;
+        int  pos, down;
+        if (line[0] == '#' || sscanf(line, "%ld,%d,%d", &ms, &pos, &down) != 3) continue;
+        if (pos < 0 || pos >= GRID_KEYS) continue;
+
+        if (!started) {
+            offset  = ms - (long)host_now();
+            started = true;
+        }
+        while ((long)host_now() + offset < ms) host_scan();
+        replay_down[pos] = down;
+        host_key(pos, down);
+        replay_flush(offset);
+    }
+
+    // A log cut mid-hold: let go of everything, then let every timer run out
+    for (uint8_t pos = 0; pos < GRID_KEYS; pos++) {
+        if (replay_down[pos]) host_key(pos, false);
+    }
+    host_idle(5000);
+    replay_flush(offset);
+    return 0;
+}
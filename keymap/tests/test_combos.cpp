@@ -0,0 +1,97 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * COMBO LAYER SCENARIOS
+ * Which combos fire on which layer - the positional table keeps the set the keycode combos fired on,
+ * through whatever each layer leaves transparent
+ */
+
+#include "keymap_fixture.h"
+
+class Combos : public KeymapTest {
+   protected:
+    // Both keys inside every combo term, held, released together
+    void chord(uint8_t first, uint8_t second) {
+        press(first);
+        idle(5);
+        press(second);
+        idle(40);
+        release(first);
+        release(second);
+        idle(1);
+    }
+
+    void nav_on() {
+        press(G_SPC);
+        idle(TAPPING_TERM + 20);
+        host_reports_clear();
+    }
+};
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  NAV                                                                                               ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Arrow keys under N E I - two arrows, never the parenthesis combos
+TEST_F(Combos, NavArrowsAreNotParens) {
+    nav_on();
+    chord(G_N, G_E);
+    chord(G_E, G_I);
+
+    EXPECT_EQ(typed(), "<80><81><81><79>");
+}
+
+// , and . are transparent on NAV - the ] combo sends } there
+TEST_F(Combos, NavCommaDotIsBrace) {
+    nav_on();
+    chord(G_COMM, G_DOT);
+
+    EXPECT_EQ(typed(), "<S-48>");
+}
+
+// L U Y are the NAV backspace/delete hold-taps - same combos as on the base layer
+TEST_F(Combos, NavBackspaceAndDelete) {
+    nav_on();
+    chord(G_L, G_U);
+    chord(G_U, G_Y);
+
+    EXPECT_EQ(typed(), "<42><76>");
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TRANSPARENT KEYS ON OTHER LAYERS                                                                  ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+TEST_F(Combos, MouseKeepsEscape) {
+    layer_on(_MOUSE);
+    chord(G_W, G_F);
+    layer_off(_MOUSE);
+
+    EXPECT_EQ(typed(), "<41>");
+}
+
+TEST_F(Combos, FnKeepsPercent) {
+    layer_on(_FN);
+    chord(G_B, G_G);
+    layer_off(_FN);
+
+    EXPECT_EQ(typed(), "<S-34>");
+}
+
+TEST_F(Combos, SysKeepsBrackets) {
+    layer_on(_SYS);
+    chord(G_H, G_COMM);
+    chord(G_COMM, G_DOT);
+    layer_off(_SYS);
+
+    EXPECT_EQ(typed(), "<47><48>");
+}
+
+// Gaming as the default layer turns every combo off
+TEST_F(Combos, GamingHasNone) {
+    default_layer_set((layer_state_t)1 << _GAMING);
+    chord(G_W, G_F);
+    default_layer_set(1);
+
+    EXPECT_EQ(report_time(KC_ESC), -1);
+}
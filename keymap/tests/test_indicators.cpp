@@ -0,0 +1,104 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * RGB INDICATOR SCENARIOS
+ * The indicator frame is only rebuilt when marked dirty - every mode has to be cleared where it ends
+ */
+
+#include "keymap_fixture.h"
+
+extern "C" {
+#include "midi_enhanced.h"  // MIDI_REC_TOGGLE, MIDI_PANIC
+}
+
+class Indicators : public KeymapTest {
+   protected:
+    static constexpr uint8_t LEFT_PAIR[] = {6, 7};        // LED_LEFT - the MIDI record indicator
+    static constexpr uint8_t CORNERS[]   = {6, 7, 3, 2};  // LED_CORNERS - GAMING as the default layer
+
+    bool recording_lit() {
+        host_rgb_frame();
+        for (uint8_t led : LEFT_PAIR) {
+            RGB color = host_rgb_led(led);
+            if (color.r != 255 || color.g != 0 || color.b != 0) return false;
+        }
+        return true;
+    }
+
+    void midi_toggle() {
+        int grid = host_grid_of(get_highest_layer(layer_state) == _MIDI ? _MIDI : _DEF, MIDI);
+        ASSERT_NE(grid, -1);
+        tap(grid);
+        idle(10);
+    }
+
+    bool corners_lit() {
+        host_rgb_frame();
+        for (uint8_t led : CORNERS) {
+            RGB color = host_rgb_led(led);
+            if (color.r != 255 || color.g != 0 || color.b != 0) return false;
+        }
+        return true;
+    }
+
+    void record_toggle() {
+        int grid = host_grid_of(_MIDI, MIDI_REC_TOGGLE);
+        ASSERT_NE(grid, -1);
+        tap(grid);
+    }
+};
+
+TEST_F(Indicators, MidiRecordLightsWhileRecording) {
+    midi_toggle();
+    ASSERT_EQ(get_highest_layer(layer_state), _MIDI);
+    EXPECT_FALSE(recording_lit());
+
+    record_toggle();
+    EXPECT_TRUE(recording_lit());
+    record_toggle();
+    EXPECT_FALSE(recording_lit());
+}
+
+// Leaving MIDI panics, which stops recording - the LED goes with it and stays off on the way back in
+TEST_F(Indicators, MidiExitClearsRecord) {
+    midi_toggle();
+    record_toggle();
+    ASSERT_TRUE(recording_lit());
+
+    midi_toggle();
+    ASSERT_NE(get_highest_layer(layer_state), _MIDI);
+    EXPECT_FALSE(recording_lit());
+
+    midi_toggle();
+    EXPECT_FALSE(recording_lit());
+}
+
+TEST_F(Indicators, MidiPanicClearsRecord) {
+    midi_toggle();
+    record_toggle();
+    ASSERT_TRUE(recording_lit());
+
+    int grid = host_grid_of(_MIDI, MIDI_PANIC);
+    ASSERT_NE(grid, -1);
+    tap(grid);
+    EXPECT_FALSE(recording_lit());
+}
+
+// GAMING is a default layer - the corners follow default_layer_state, and tournament mode turns RGB off
+TEST_F(Indicators, GamingCornersFollowDefaultLayer) {
+    tap(G_GAMING);
+    idle(10);  // Housekeeping enters tournament mode
+    ASSERT_EQ(get_highest_layer(default_layer_state), _GAMING);
+#ifdef TOURNAMENT_MODE
+    EXPECT_FALSE(rgb_matrix_is_enabled());
+    EXPECT_FALSE(corners_lit());
+#else
+    EXPECT_TRUE(corners_lit());
+#endif
+
+    tap(G_GAMING);  // DEF on the gaming layer
+    idle(10);
+    ASSERT_EQ(get_highest_layer(default_layer_state), _DEF);
+    EXPECT_TRUE(rgb_matrix_is_enabled());
+    EXPECT_FALSE(corners_lit());
+}
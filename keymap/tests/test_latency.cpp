@@ -0,0 +1,438 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * LATENCY SCENARIOS
+ * Timed key sequences through the whole keymap - each asserts what the host receives and how many ms
+ * after the deciding input it arrives, against the budgets in latency_budget.h
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "keymap_fixture.h"
+
+class Latency : public KeymapTest {};
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  HOMEROW MODS                                                                                      ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Chordal hold: a same-hand key settles the mod-tap as a tap the moment it goes down
+TEST_F(Latency, HrmSameHandRollTapsAtSecondPress) {
+    uint32_t t0 = host_now();
+    press(G_A);
+    idle(30);
+    uint32_t t1 = host_now();
+    press(G_Z);  // Same hand, in no combo - nothing else holds it back
+    idle(20);
+    release(G_A);
+    idle(20);
+    release(G_Z);
+    idle(1);
+
+    EXPECT_EQ(typed(), "az");
+    EXPECT_EQ(report_time(KC_A), (long)t1);
+    EXPECT_EQ(report_time(KC_Z), (long)t1);
+    EXPECT_LE(t1 - t0, (uint32_t)LATENCY_BUDGET_HOLD);
+    EXPECT_EQ(mods_time(0xFF), -1);
+}
+
+// Flow tap: mid-word, a homerow mod types its letter on press - zero hold-back of its own
+TEST_F(Latency, HrmMidWordTapsAtPress) {
+    tap(G_Q);
+    idle(40);
+    uint32_t t0 = host_now();
+    tap(G_A);  // In no combo: on press
+    idle(40);
+    uint32_t t1 = host_now();
+    press(G_T);  // P+T ($, 30 ms) is its slowest combo candidate - waits out that term, then taps
+    idle(60);
+    release(G_T);
+    idle(1);
+
+    EXPECT_EQ(typed(), "qat");
+    EXPECT_EQ(report_time(KC_A), (long)t0);
+    EXPECT_EQ(report_time(KC_T), (long)(t1 + 30));
+    EXPECT_LE(report_time(KC_T) - (long)t1, LATENCY_BUDGET_COMBO);
+    EXPECT_EQ(mods_time(0xFF), -1);
+}
+
+// Bilateral: opposite-hand key pressed inside the mod → hold, decided at that press
+TEST_F(Latency, HrmOppositeHandNestedTapHolds) {
+    press(G_S);
+    idle(60);
+    uint32_t t1 = host_now();
+    press(11);  // ' - no combo on it
+    idle(30);
+    release(11);
+    idle(20);
+    release(G_S);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<S-52>");
+    EXPECT_EQ(report_time(KC_QUOT), (long)t1);
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LSFT)), (long)t1);
+}
+
+// Hold on other key press: the opposite-hand press alone is enough - no release, well inside the term
+TEST_F(Latency, HrmOppositeHandPressHoldsAtOnce) {
+    uint32_t t0 = host_now();
+    press(G_T);
+    idle(60);
+    uint32_t t1 = host_now();
+    press(11);  // ' - no combo on it, still held
+    idle(20);
+
+    EXPECT_LT(host_now() - t0, (uint32_t)TAPPING_TERM);
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LCTL)), (long)t1);
+    EXPECT_EQ(report_time(KC_QUOT), (long)t1);
+}
+
+// Alone past the term: the mod goes out at TAPPING_TERM, not on release
+TEST_F(Latency, HrmHeldAloneHoldsAtTerm) {
+    uint32_t t0 = host_now();
+    press(G_A);
+    idle(TAPPING_TERM + 50);
+    release(G_A);
+    idle(1);
+
+    EXPECT_EQ(typed(), "");
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LGUI)), (long)(t0 + TAPPING_TERM));
+    EXPECT_LE((uint32_t)TAPPING_TERM, (uint32_t)LATENCY_BUDGET_HOLD);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  SMART_SPC                                                                                         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Roll out of space: the next key waits in the hold-tap buffer and lands on the base layer
+TEST_F(Latency, SmartSpcRollReplaysOnBaseLayer) {
+    press(G_SPC);
+    idle(40);
+    press(G_Q);
+    idle(20);
+    uint32_t t1 = host_now();
+    release(G_SPC);
+    idle(20);
+    release(G_Q);
+    idle(1);
+
+    EXPECT_EQ(typed(), " q");
+    EXPECT_EQ(report_time(KC_SPC), (long)t1);
+    EXPECT_EQ(report_time(KC_Q), (long)t1);  // Held back exactly until space resolved
+}
+
+// A combo key rolled over space: the combo engine holds it once at scan time, never again on replay
+TEST_F(Latency, SmartSpcRollReplaysPastCombos) {
+    press(G_SPC);
+    idle(40);
+    press(G_W);  // In W+F and W+R - waits COMBO_TERM, then queues behind space
+    idle(30);
+    uint32_t t1 = host_now();
+    release(G_SPC);
+    idle(20);
+    release(G_W);
+    idle(200);  // Event log drains when idle
+
+    EXPECT_EQ(typed(), " w");
+    EXPECT_EQ(report_time(KC_W), (long)t1);
+    std::string console = host_console();
+    size_t first = console.find("Raw pos=1 down=1");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_EQ(console.find("Raw pos=1 down=1", first + 1), std::string::npos);  // Logged once
+}
+
+// Key pressed and released inside the space: NAV hold, decided at that release
+TEST_F(Latency, SmartSpcNestedTapHoldsNav) {
+    press(G_SPC);
+    idle(40);
+    press(G_J);  // PGUP on NAV
+    idle(30);
+    uint32_t t1 = host_now();
+    release(G_J);
+    idle(20);
+    release(G_SPC);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<75>");
+    EXPECT_EQ(report_time(KC_PGUP), (long)t1);
+}
+
+// Held alone: NAV comes on at TAPPING_TERM
+TEST_F(Latency, SmartSpcHeldAloneHoldsAtTerm) {
+    uint32_t t0 = host_now();
+    press(G_SPC);
+    idle(TAPPING_TERM);
+    EXPECT_FALSE(layer_state_cmp(layer_state, _NAV));
+    idle(1);  // The scan at press + TAPPING_TERM runs the term callback
+    EXPECT_TRUE(layer_state_cmp(layer_state, _NAV));
+    EXPECT_LE(host_now() - 1 - t0, (uint32_t)LATENCY_BUDGET_HOLD);
+    release(G_SPC);
+    idle(1);
+    EXPECT_FALSE(layer_state_cmp(layer_state, _NAV));
+    EXPECT_EQ(typed(), "");
+}
+
+// Mid-word (require-prior-idle): space is a tap on press
+TEST_F(Latency, SmartSpcMidWordTapsAtPress) {
+    tap(G_Q);
+    idle(40);
+    uint32_t t0 = host_now();
+    tap(G_SPC);
+
+    EXPECT_EQ(typed(), "q ");
+    EXPECT_EQ(report_time(KC_SPC), (long)t0);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  NAV STREAKS                                                                                       ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Held: the jump goes out at TAPPING_TERM from the press, while the key is still down
+TEST_F(Latency, NavHoldFiresAtTerm) {
+    press(G_SPC);
+    idle(TAPPING_TERM + 20);  // NAV on
+    host_reports_clear();
+
+    uint32_t t0 = host_now();
+    press(G_U);  // U_NAV_U - hold is Ctrl+Home
+    idle(TAPPING_TERM + 100);
+    release(G_U);
+    idle(1);
+    release(G_SPC);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<74>");
+    EXPECT_EQ(report_time(KC_HOME), (long)(t0 + TAPPING_TERM));
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LCTL)), (long)(t0 + TAPPING_TERM));
+    EXPECT_EQ(report_time(KC_UP), -1);
+}
+
+// Released inside the term: the tap goes out on the release itself
+TEST_F(Latency, NavTapFiresOnRelease) {
+    press(G_SPC);
+    idle(TAPPING_TERM + 20);
+    host_reports_clear();
+
+    press(G_U);
+    idle(100);
+    uint32_t t1 = host_now();
+    release(G_U);
+    idle(1);
+    release(G_SPC);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<82>");
+    EXPECT_EQ(report_time(KC_UP), (long)t1);
+    EXPECT_EQ(mods_time(0xFF), -1);
+}
+
+// Tap on release, re-press inside STREAK_TIMEOUT repeats at once and auto-repeats while held
+TEST_F(Latency, NavStreakRepeatsWithoutHold) {
+    press(G_SPC);
+    idle(TAPPING_TERM + 20);  // NAV on
+    host_reports_clear();
+
+    press(G_L);  // U_NAV_BS
+    idle(40);
+    uint32_t t1 = host_now();
+    release(G_L);
+    idle(60);
+    uint32_t t2 = host_now();
+    press(G_L);
+    idle(15 + STREAK_REPEAT_DELAY + STREAK_REPEAT_INTERVAL + 5);  // Backspace combo term, then two repeats
+    release(G_L);
+    idle(1);
+    release(G_SPC);
+    idle(1);
+
+    EXPECT_EQ(report_time(KC_BSPC), (long)t1);  // Tap: on release, no extra delay
+    long streak = report_time(KC_BSPC, t1 + 1);
+    ASSERT_NE(streak, -1);
+    EXPECT_EQ(streak, (long)(t2 + 15));  // Only the NAV backspace combo holds it back
+    EXPECT_LE(streak - (long)t2, LATENCY_BUDGET_COMBO);
+    EXPECT_EQ(typed(), "<42><42><42><42>");  // Tap, streak tap, two auto-repeats
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LCTL)), -1);  // Never the Ctrl+Backspace hold
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  COMBOS                                                                                            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Plain keys: fires on the second press - no candidate can extend W+F
+TEST_F(Latency, ComboFiresOnLastPress) {
+    uint32_t t0 = host_now();
+    press(G_W);
+    idle(8);
+    uint32_t t1 = host_now();
+    press(G_F);
+    idle(30);
+    release(G_W);
+    release(G_F);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<41>");
+    EXPECT_EQ(report_time(KC_ESC), (long)t1);
+    EXPECT_LE(t1 - t0, (uint32_t)LATENCY_BUDGET_COMBO);
+}
+
+// Homerow mods: N+E is ( - the mod-taps never start
+TEST_F(Latency, ComboOverHomerowMods) {
+    press(G_N);
+    idle(10);
+    uint32_t t1 = host_now();
+    press(G_E);
+    idle(60);
+    release(G_N);
+    release(G_E);
+    idle(1);
+
+    EXPECT_EQ(typed(), "<S-38>");
+    EXPECT_EQ(report_time(KC_9), (long)t1);
+}
+
+// A lone combo key goes out when its slowest candidate's term runs out
+TEST_F(Latency, ComboKeyAloneWaitsForTerm) {
+    uint32_t t0 = host_now();
+    press(G_W);
+    idle(60);
+    release(G_W);
+    idle(1);
+
+    EXPECT_EQ(typed(), "w");
+    long sent = report_time(KC_W);
+    EXPECT_EQ(sent, (long)(t0 + COMBO_TERM));
+    EXPECT_LE(sent - (long)t0, LATENCY_BUDGET_COMBO);
+}
+
+// Second key after the term: both type themselves, in order
+TEST_F(Latency, ComboTooSlowTypesBothKeys) {
+    press(G_W);
+    idle(COMBO_TERM + 10);
+    press(G_F);
+    idle(40);
+    release(G_W);
+    release(G_F);
+    idle(1);
+
+    EXPECT_EQ(typed(), "wf");
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  NUM-WORD                                                                                          ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Digits keep num-word on, the first other key leaves it - and is typed on the base layer at once
+TEST_F(Latency, NumWordExitsOnNonDigit) {
+    tap(G_NUM);
+    EXPECT_TRUE(layer_state_cmp(layer_state, _NUM));
+    idle(200);
+    tap(G_W);  // 7
+    tap(G_F);  // 8
+    EXPECT_TRUE(layer_state_cmp(layer_state, _NUM));
+    uint32_t t0 = host_now();
+    tap(11);   // '
+
+    EXPECT_FALSE(layer_state_cmp(layer_state, _NUM));
+    EXPECT_EQ(typed(), "<36><37><52>");
+    EXPECT_EQ(report_time(KC_QUOT), (long)t0);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  CAPS-WORD                                                                                         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Letters go out shifted; a shortcut on the base layer is not a letter - no Shift, and caps-word ends
+TEST_F(Latency, CapsWordShiftsLettersNotShortcuts) {
+    tap(G_SHIFT);
+    tap(G_SHIFT);  // Double tap: caps-word
+    idle(200);
+    tap(G_Q);
+    idle(40);
+    host_reports_clear();
+
+    uint32_t t0 = host_now();
+    tap(17);  // LGUI(KC_Z) - undo
+    idle(200);
+    tap(G_Q);
+
+    EXPECT_NE(report_time(KC_Z), -1);
+    EXPECT_EQ(mods_time(MOD_MASK_SHIFT), -1);
+    EXPECT_EQ(mods_time(MOD_BIT(KC_LGUI)), (long)t0);
+    EXPECT_EQ(typed(), "zq");  // Caps-word is over - the q after it is lower case
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  SOCD (GAMING)                                                                                     ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Last input wins, the held key comes back when it's released - every change in the same ms
+TEST_F(Latency, SocdLastInputOnGaming) {
+    tap(G_GAMING);
+    idle(10);
+    ASSERT_EQ(get_highest_layer(default_layer_state), _GAMING);
+    host_reports_clear();
+
+    uint32_t t0 = host_now();
+    press(G_R);  // A on QWERTY
+    idle(20);
+    uint32_t t1 = host_now();
+    press(G_T);  // D
+    idle(20);
+    uint32_t t2 = host_now();
+    release(G_T);
+    idle(20);
+    release(G_R);
+    idle(1);
+
+    EXPECT_EQ(report_time(KC_A), (long)t0);
+    EXPECT_EQ(report_time(KC_D), (long)t1);
+    ASSERT_GE(host_report_count(), 3u);
+    EXPECT_FALSE(host_report_has(host_report(1), KC_A));  // D replaced A
+    EXPECT_EQ(report_time(KC_A, t1 + 1), (long)t2);       // A restored on D's release
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  TOURNAMENT MODE (GAMING)                                                                          ║
+ * ║  test_latency runs with TOURNAMENT_MODE, test_latency_full without - same scenario, both paths     ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+extern "C" void latency_trace_dump(void);
+
+// Every gaming-layer press is traced to the report it changes - the 6KRO one without tournament mode, the
+// forced NKRO one with it. On the 1 ms clock both go out in the scan that saw the key - what tournament
+// mode saves is CPU time per event (test_tournament pins the work it skips), not a whole scan
+TEST_F(Latency, GamingKeyToReport) {
+    tap(G_GAMING);
+    idle(10);
+    ASSERT_EQ(get_highest_layer(default_layer_state), _GAMING);
+#ifdef TOURNAMENT_MODE
+    EXPECT_TRUE(keymap_config.nkro);
+#else
+    EXPECT_FALSE(keymap_config.nkro);
+#endif
+
+    unsigned presses = 0;
+    for (int i = 0; i < 4; i++) {
+        press(G_R);  // A
+        idle(20);
+        press(G_T);  // D - SOCD swaps it in
+        idle(20);
+        release(G_T);
+        idle(20);
+        release(G_R);
+        idle(50);
+        tap(G_SPC);
+        idle(50);
+        presses += 3;
+    }
+
+    host_console_clear();
+    latency_trace_dump();
+    const char *row = strstr(host_console(), "gaming ");
+    ASSERT_NE(row, nullptr) << host_console();
+    unsigned count = 0, avg = 0, max = 0;
+    ASSERT_EQ(sscanf(row, "gaming n=%u avg=%u max=%u", &count, &avg, &max), 3);
+    EXPECT_EQ(count, presses);
+    EXPECT_EQ(max, 0u);
+}
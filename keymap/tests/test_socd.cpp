@@ -0,0 +1,137 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * SOCD MODE SCENARIOS
+ * socd.h on its own with a pair table of its own - one pair per mode - checking what the host holds
+ * after every edge
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+extern "C" {
+#include "qmk_stub.h"
+#include "socd.h"
+
+const socd_pair_t socd_pairs[] = {
+    {{KC_A,    KC_D},    SOCD_LAST},
+    {{KC_W,    KC_S},    SOCD_FIRST},
+    {{KC_LEFT, KC_RGHT}, SOCD_NEUTRAL},
+    {{KC_UP,   KC_DOWN}, SOCD_ABSOLUTE},
+};
+const uint8_t socd_pair_count = ARRAY_SIZE(socd_pairs);
+}
+
+class Socd : public ::testing::Test {
+   protected:
+    // What the engine makes of one edge - false when it took the key
+    bool key(uint16_t keycode, bool pressed, bool active = true) {
+        keyrecord_t record   = {};
+        record.event.type    = KEY_EVENT;
+        record.event.pressed = pressed;
+        record.event.time    = timer_read();
+        return process_socd(keycode, &record, active);
+    }
+
+    // Keys down in the last report the host received
+    std::set<uint16_t> held() const {
+        std::set<uint16_t> keys;
+        if (host_report_count() == 0) return keys;
+        const host_report_t *report = host_report(host_report_count() - 1);
+        for (uint16_t code = 1; code <= 0xFF; code++) {
+            if (host_report_has(report, code)) keys.insert(code);
+        }
+        return keys;
+    }
+
+    using keys = std::set<uint16_t>;
+};
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  MODES                                                                                             ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+// Snap tap: the newer key replaces the held one, which comes back when the newer one is released
+TEST_F(Socd, LastInputWinsAndRestores) {
+    EXPECT_FALSE(key(KC_A, true));
+    EXPECT_EQ(held(), keys{KC_A});
+    EXPECT_FALSE(key(KC_D, true));
+    EXPECT_EQ(held(), keys{KC_D});
+    EXPECT_FALSE(key(KC_D, false));
+    EXPECT_EQ(held(), keys{KC_A});
+    EXPECT_FALSE(key(KC_A, false));
+    EXPECT_EQ(held(), keys{});
+}
+
+// Letting go of the older key leaves the newer one alone - no extra report
+TEST_F(Socd, LastInputReleasingOlderKeepsNewer) {
+    key(KC_A, true);
+    key(KC_D, true);
+    size_t reports = host_report_count();
+    key(KC_A, false);
+
+    EXPECT_EQ(host_report_count(), reports);
+    EXPECT_EQ(held(), keys{KC_D});
+}
+
+TEST_F(Socd, FirstInputWinsUntilReleased) {
+    key(KC_W, true);
+    key(KC_S, true);
+    EXPECT_EQ(held(), keys{KC_W});
+    key(KC_W, false);
+    EXPECT_EQ(held(), keys{KC_S});  // The waiting key goes out
+    key(KC_S, false);
+    EXPECT_EQ(held(), keys{});
+}
+
+TEST_F(Socd, NeutralCancelsBoth) {
+    key(KC_LEFT, true);
+    EXPECT_EQ(held(), keys{KC_LEFT});
+    key(KC_RGHT, true);
+    EXPECT_EQ(held(), keys{});
+    key(KC_LEFT, false);
+    EXPECT_EQ(held(), keys{KC_RGHT});  // Restored once it's alone again
+}
+
+TEST_F(Socd, AbsoluteFirstKeyAlwaysWins) {
+    key(KC_DOWN, true);
+    key(KC_UP, true);
+    EXPECT_EQ(held(), keys{KC_UP});
+    key(KC_UP, false);
+    EXPECT_EQ(held(), keys{KC_DOWN});
+
+    key(KC_UP, true);
+    key(KC_DOWN, false);
+    key(KC_DOWN, true);  // Pressed last, still loses
+    EXPECT_EQ(held(), keys{KC_UP});
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  PAIRS AND SWITCHING                                                                               ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+TEST_F(Socd, PairsResolveIndependently) {
+    key(KC_A, true);
+    key(KC_W, true);
+    key(KC_D, true);
+    key(KC_S, true);
+
+    EXPECT_EQ(held(), (keys{KC_D, KC_W}));
+}
+
+TEST_F(Socd, OtherKeysPassThrough) {
+    EXPECT_TRUE(key(KC_Q, true));
+    EXPECT_TRUE(key(KC_Q, false));
+    EXPECT_EQ(host_report_count(), 0u);
+}
+
+// Off (not on GAMING): presses pass through, but a key taken while on is still released by the engine
+TEST_F(Socd, InactiveTakesOnlyItsOwnReleases) {
+    EXPECT_TRUE(key(KC_D, true, false));
+    EXPECT_TRUE(key(KC_D, false, false));
+
+    key(KC_A, true);
+    EXPECT_FALSE(key(KC_A, false, false));
+    EXPECT_EQ(held(), keys{});
+}
@@ -0,0 +1,76 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * TOURNAMENT FAST PATH
+ * keymap.c built with -finstrument-functions - every function it enters is counted, so a key on the
+ * bare gaming layer can be checked for what it never reaches: the combo engine and the hold-tap buffer
+ */
+
+#include "keymap_fixture.h"
+
+extern "C" {
+bool process_combo_engine(uint16_t keycode, keyrecord_t *record);
+bool hold_tap_buffer_event(uint16_t keycode, keyrecord_t *record);
+
+static unsigned combo_calls, buffer_calls;
+
+void __cyg_profile_func_enter(void *fn, void *caller) {
+    if (fn == (void *)process_combo_engine) combo_calls++;
+    if (fn == (void *)hold_tap_buffer_event) buffer_calls++;
+}
+void __cyg_profile_func_exit(void *fn, void *caller) {}
+}
+
+class Tournament : public KeymapTest {
+   protected:
+    void gaming_on() {
+        tap(G_GAMING);
+        idle(10);  // Housekeeping enters the mode
+        ASSERT_EQ(get_highest_layer(default_layer_state), _GAMING);
+        combo_calls = buffer_calls = 0;
+    }
+
+    // A burst of WASD-style play: opposing directions, a held key, a tap
+    void play() {
+        press(G_R);  // A
+        idle(10);
+        press(G_T);  // D
+        idle(10);
+        release(G_T);
+        idle(10);
+        tap(G_SPC);
+        release(G_R);
+        idle(10);
+    }
+};
+
+// Control: the same keys on the base layer go through both
+TEST_F(Tournament, BaseLayerUsesTheEngines) {
+    combo_calls = buffer_calls = 0;
+    play();
+
+    EXPECT_GT(combo_calls, 0u);
+    EXPECT_GT(buffer_calls, 0u);
+}
+
+TEST_F(Tournament, GamingLayerSkipsTheEngines) {
+    gaming_on();
+    play();
+
+    EXPECT_EQ(combo_calls, 0u);
+    EXPECT_EQ(buffer_calls, 0u);
+    EXPECT_NE(report_time(KC_A), -1);  // Keys still reach the host
+}
+
+// A momentary layer on top takes the full path again
+TEST_F(Tournament, LayerOnTopUsesTheEngines) {
+    gaming_on();
+    press(39);  // MO(_NUM)
+    idle(10);
+    play();
+    release(39);
+    idle(1);
+
+    EXPECT_GT(combo_calls, 0u);
+    EXPECT_GT(buffer_calls, 0u);
+}
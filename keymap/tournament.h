@@ -0,0 +1,99 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * TOURNAMENT MODE
+ * Lowest-latency pipeline while GAMING is the default layer - SOCD only, everything else goes straight to
+ * QMK, NKRO forced on, RGB and music paused
+ * Compiled in with TOURNAMENT_MODE
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "custom_keycodes.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  MODE SWITCH                                                                                       ║
+ * ║  default_layer_state_set_user requests, housekeeping applies - the default layer is also restored  ║
+ * ║  from EEPROM before RGB and audio are up, so nothing is touched from the layer hook itself         ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#ifdef TOURNAMENT_MODE
+
+static bool tournament_wanted = false;
+static bool tournament_active = false;
+
+// What the mode paused, restored as found on the way out
+static struct {
+    bool nkro, override, rgb, music, debug;
+} tournament_saved;
+
+// Bypass only on the gaming layer itself - NUM and SYS on top keep their full processing
+static inline bool tournament_fast_path(void) {
+    return tournament_active && !layer_state;
+}
+
+// Call from default_layer_state_set_user
+static inline void tournament_request(layer_state_t state) {
+    tournament_wanted = get_highest_layer(state) == _GAMING;
+}
+
+static void tournament_enter(void) {
+#    ifdef NKRO_ENABLE
+    tournament_saved.nkro = keymap_config.nkro;
+    if (!keymap_config.nkro) {
+        clear_keyboard();  // Held keys would be stuck in the 6KRO report
+        keymap_config.nkro = true;
+    }
+#    endif
+#    ifdef KEY_OVERRIDE_ENABLE
+    tournament_saved.override = key_override_is_enabled();
+    key_override_off();
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    tournament_saved.rgb = rgb_matrix_is_enabled();
+    rgb_matrix_disable_noeeprom();
+#    endif
+#    ifdef AUDIO_ENABLE
+    tournament_saved.music = is_music_on();
+    if (tournament_saved.music) music_off();
+#    endif
+    tournament_saved.debug = debug_enable;
+    debug_enable           = false;
+}
+
+static void tournament_leave(void) {
+#    ifdef NKRO_ENABLE
+    if (keymap_config.nkro != tournament_saved.nkro) {
+        clear_keyboard();
+        keymap_config.nkro = tournament_saved.nkro;
+    }
+#    endif
+#    ifdef KEY_OVERRIDE_ENABLE
+    if (tournament_saved.override) key_override_on();
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    if (tournament_saved.rgb) rgb_matrix_enable_noeeprom();
+#    endif
+#    ifdef AUDIO_ENABLE
+    if (tournament_saved.music) music_on();
+#    endif
+    debug_enable = tournament_saved.debug;
+}
+
+// Call from housekeeping_task_user
+void tournament_task(void) {
+    if (tournament_wanted == tournament_active) return;
+
+    if (tournament_wanted) tournament_enter();
+    else                   tournament_leave();
+    tournament_active = tournament_wanted;
+}
+
+#else
+
+#    define tournament_fast_path() false
+static inline void tournament_request(layer_state_t state) {}
+static inline void tournament_task(void) {}
+
+#endif
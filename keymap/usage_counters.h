@@ -0,0 +1,148 @@
+/* Copyright 2015-2023 Jack Humbert
+ * GPL-2.0-or-later
+ *
+ * USAGE COUNTERS OVER RAW HID
+ * Live RAM counters (presses per key per layer, homerow tap/hold, combos, leader) streamed to
+ * heatmap.py on request - reads are answered from the USB task, the scan loop never stops
+ * Compiled in with RAW_ENABLE
+ */
+
+#pragma once
+
+#include QMK_KEYBOARD_H
+#include "raw_hid.h"
+#include "adaptive_term.h"  // Homerow finger index of a mod-tap
+#include "leader_trie.h"
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  COUNTERS                                                                                          ║
+ * ║  Key order is LAYOUT_planck_grid order - the keypos-N numbering of the draw/ layer SVGs            ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define USAGE_KEYS   48                      // Planck grid positions
+#define USAGE_LAYERS 8                       // enum planck_layers
+#ifndef USAGE_COMBOS
+#    define USAGE_COMBOS 64                  // Capacity - combo_engine.h asserts COMBO_LENGTH fits
+#endif
+#define USAGE_LEADER ARRAY_SIZE(leader_trie) // One counter per trie node, only leaves count
+
+static const uint8_t usage_layout_index[MATRIX_ROWS][MATRIX_COLS] PROGMEM = LAYOUT_planck_grid(
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,
+    12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47
+);
+
+static uint16_t usage_presses[USAGE_LAYERS][USAGE_KEYS];
+static uint16_t usage_hrm_taps[ADAPTIVE_TERM_KEYS];
+static uint16_t usage_hrm_holds[ADAPTIVE_TERM_KEYS];
+static uint16_t usage_combos[USAGE_COMBOS];
+static uint16_t usage_leader[USAGE_LEADER];
+
+static inline void usage_count(uint16_t *counter) {
+    if (*counter < UINT16_MAX) (*counter)++;
+}
+
+// Call at the top of process_record_user - each press arrives once, on the layer it resolved on
+void usage_count_record(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) return;
+    keypos_t key = record->event.key;
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return;  // Combo outputs count as combos
+
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    if (layer < USAGE_LAYERS) usage_count(&usage_presses[layer][pgm_read_byte(&usage_layout_index[key.row][key.col])]);
+
+    uint8_t finger = adaptive_term_index(keycode);
+    if (finger != ADAPTIVE_TERM_NONE && IS_QK_MOD_TAP(keycode)) {
+        usage_count(record->tap.count ? &usage_hrm_taps[finger] : &usage_hrm_holds[finger]);
+    }
+}
+
+void usage_count_combo(uint16_t index) {
+    if (index < USAGE_COMBOS) usage_count(&usage_combos[index]);
+}
+
+void usage_count_leader(uint16_t node) {
+    if (node < USAGE_LEADER) usage_count(&usage_leader[node]);
+}
+
+/* ╔════════════════════════════════════════════════════════════════════════════════════════════════════╗
+ * ║  RAW HID PROTOCOL                                                                                  ║
+ * ║  32-byte reports, little-endian - every request is answered in place                               ║
+ * ║  INFO  [01]                  → [01 version tables len0 len1 ...]  (uint16 lengths)                 ║
+ * ║  READ  [02 table off off]    → [02 table off off n v0 v0 v1 v1 ...] (n ≤ 13 uint16 values)         ║
+ * ║  RESET [03]                  → [03]                                                                ║
+ * ╚════════════════════════════════════════════════════════════════════════════════════════════════════╝ */
+
+#define USAGE_HID_VERSION 1
+#define USAGE_HID_VALUES  13  // (32 - 5 header bytes) / 2
+
+enum usage_hid_command {
+    USAGE_HID_INFO  = 0x01,
+    USAGE_HID_READ  = 0x02,
+    USAGE_HID_RESET = 0x03,
+    USAGE_HID_ERROR = 0xFF,
+};
+
+enum usage_table {
+    USAGE_TABLE_PRESSES,    // [layer][key]
+    USAGE_TABLE_HRM_TAPS,   // [finger] A R S T N E I O
+    USAGE_TABLE_HRM_HOLDS,
+    USAGE_TABLE_COMBOS,     // [enum combo_events]
+    USAGE_TABLE_LEADER,     // [leader_trie node]
+    USAGE_TABLES
+};
+
+typedef struct {
+    uint16_t *data;
+    uint16_t  length;
+} usage_table_t;
+
+static const usage_table_t usage_tables[USAGE_TABLES] = {
+    [USAGE_TABLE_PRESSES]   = {&usage_presses[0][0], USAGE_LAYERS * USAGE_KEYS},
+    [USAGE_TABLE_HRM_TAPS]  = {usage_hrm_taps,       ADAPTIVE_TERM_KEYS},
+    [USAGE_TABLE_HRM_HOLDS] = {usage_hrm_holds,      ADAPTIVE_TERM_KEYS},
+    [USAGE_TABLE_COMBOS]    = {usage_combos,         USAGE_COMBOS},
+    [USAGE_TABLE_LEADER]    = {usage_leader,         USAGE_LEADER},
+};
+
+static void usage_put16(uint8_t *out, uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+// Call from raw_hid_receive
+void usage_hid_receive(uint8_t *data, uint8_t length) {
+    switch (data[0]) {
+        case USAGE_HID_INFO:
+            data[1] = USAGE_HID_VERSION;
+            data[2] = USAGE_TABLES;
+            for (uint8_t t = 0; t < USAGE_TABLES; t++) usage_put16(&data[3 + t * 2], usage_tables[t].length);
+            break;
+
+        case USAGE_HID_READ: {
+            uint8_t  table  = data[1];
+            uint16_t offset = data[2] | (uint16_t)data[3] << 8;
+            if (table >= USAGE_TABLES || offset > usage_tables[table].length) {
+                data[0] = USAGE_HID_ERROR;
+                break;
+            }
+
+            uint8_t count = MIN(USAGE_HID_VALUES, usage_tables[table].length - offset);
+            data[4]       = count;
+            for (uint8_t i = 0; i < count; i++) usage_put16(&data[5 + i * 2], usage_tables[table].data[offset + i]);
+            break;
+        }
+
+        case USAGE_HID_RESET:
+            for (uint8_t t = 0; t < USAGE_TABLES; t++) {
+                memset(usage_tables[t].data, 0, usage_tables[t].length * sizeof(uint16_t));
+            }
+            break;
+
+        default:
+            data[0] = USAGE_HID_ERROR;
+            break;
+    }
+    raw_hid_send(data, length);
+}
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+Leader Sequence Trie Generator
+Compiles keymap/leader_sequences.txt into the PROGMEM trie in keymap/leader_trie.h
+"""
+
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent
+SOURCE = ROOT / 'keymap' / 'leader_sequences.txt'
+TARGET = ROOT / 'keymap' / 'leader_trie.h'
+
+MODES = {'MACOS', 'WINCOMPOSE', 'LINUX'}
+
+
+class Node:
+    def __init__(self, key='KC_NO', path=''):
+        self.key = key
+        self.path = path
+        self.children = {}
+        self.action = 'LEADER_ACT_NONE'
+        self.lower = 0
+        self.upper = 0
+        self.comment = ''
+        self.index = 0
+
+
+def keycode(token: str) -> str:
+    """Map a sequence token (a-z, 0-9) to its basic QMK keycode."""
+    if re.fullmatch(r'[a-z0-9]', token):
+        return f'KC_{token.upper()}'
+    raise ValueError(f'unsupported key "{token}" (use a-z or 0-9)')
+
+
+def codepoint(token: str) -> int:
+    match = re.fullmatch(r'U\+([0-9A-Fa-f]{1,4})', token)
+    if not match:
+        raise ValueError(f'bad code point "{token}" (expected U+XXXX, Basic Multilingual Plane)')
+    return int(match.group(1), 16)
+
+
+def parse(path: Path) -> Node:
+    root = Node()
+    for lineno, raw in enumerate(path.read_text(encoding='utf-8').splitlines(), 1):
+        line, _, comment = raw.partition('#')
+        if not line.strip():
+            continue
+        try:
+            keys, arrow, output = line.partition('->')
+            if not arrow:
+                raise ValueError('missing "->"')
+            keys, output = keys.split(), output.split()
+            if not keys or not output:
+                raise ValueError('empty sequence or output')
+
+            node = root
+            for depth, token in enumerate(keys, 1):
+                code = keycode(token)
+                node = node.children.setdefault(code, Node(code, ' '.join(keys[:depth])))
+            if node.action != 'LEADER_ACT_NONE':
+                raise ValueError(f'duplicate sequence "{" ".join(keys)}"')
+
+            if output[0] == 'mode':
+                if len(output) != 2 or output[1] not in MODES:
+                    raise ValueError(f'mode must be one of {", ".join(sorted(MODES))}')
+                node.action = 'LEADER_ACT_MODE'
+                node.lower = node.upper = f'UNICODE_MODE_{output[1]}'
+            else:
+                if len(output) > 2:
+                    raise ValueError('expected "lower [upper]"')
+                node.action = 'LEADER_ACT_UNICODE'
+                node.lower = codepoint(output[0])
+                node.upper = codepoint(output[-1])
+            node.comment = comment.strip()
+        except ValueError as err:
+            sys.exit(f'{path.name}:{lineno}: {err}')
+    return root
+
+
+def flatten(root: Node) -> list:
+    """Breadth-first layout so every node's children are contiguous."""
+    nodes, queue = [root], [root]
+    while queue:
+        node = queue.pop(0)
+        for child in sorted(node.children.values(), key=lambda n: n.key):
+            child.index = len(nodes)
+            nodes.append(child)
+            queue.append(child)
+    return nodes
+
+
+def value(v) -> str:
+    return v if isinstance(v, str) else f'0x{v:04X}'
+
+
+def render(nodes: list) -> str:
+    width = max(len(n.key) for n in nodes)
+    def row(n: Node, action: str, lower, upper, comment: str) -> str:
+        children = sorted(n.children.values(), key=lambda c: c.key)
+        first = children[0].index if children else 0
+        return (f'    /* {n.index:3} */ {{{n.key + ",":<{width + 1}} {action + ",":<19} '
+                f'{len(children):2}, {first:3}, {value(lower)}, {value(upper)}}},'
+                + f'  // {n.path or "root"}' + (f': {comment}' if comment else ''))
+
+    rows = []
+    for n in nodes:
+        if n.action == 'LEADER_ACT_MODE':
+            # UNICODE_MODE_* only exist with unicode - without it the node stays, so indices don't move
+            rows += ['#ifdef UNICODE_COMMON_ENABLE',
+                     row(n, n.action, n.lower, n.upper, n.comment),
+                     '#else',
+                     row(n, 'LEADER_ACT_NONE', 0, 0, 'no unicode in this build'),
+                     '#endif']
+        else:
+            rows.append(row(n, n.action, n.lower, n.upper, n.comment))
+    return '\n'.join([
+        '/* Copyright 2015-2023 Jack Humbert',
+        ' * GPL-2.0-or-later',
+        ' *',
+        ' * LEADER SEQUENCE TRIE',
+        ' * GENERATED by leader_gen.py from leader_sequences.txt - do not edit by hand, run `make leader`',
+        ' */',
+        '',
+        '#pragma once',
+        '',
+        '#include QMK_KEYBOARD_H',
+        '',
+        'enum leader_action {',
+        '    LEADER_ACT_NONE,     // Prefix only - keep reading keys',
+        '    LEADER_ACT_UNICODE,  // Send lower/upper code point',
+        '#ifdef UNICODE_COMMON_ENABLE',
+        '    LEADER_ACT_MODE,     // set_unicode_input_mode(lower)',
+        '#endif',
+        '};',
+        '',
+        '// Node 0 is the root; children of a node are contiguous and sorted by key',
+        'typedef struct {',
+        '    uint8_t  key;          // Basic keycode that leads to this node',
+        '    uint8_t  action;       // enum leader_action',
+        '    uint8_t  child_count;',
+        '    uint16_t first_child;  // Index of the first child (0 = leaf)',
+        '    uint16_t lower;        // Code point, or unicode mode for LEADER_ACT_MODE',
+        '    uint16_t upper;        // Shifted code point',
+        '} leader_node_t;',
+        '',
+        'static const leader_node_t leader_trie[] PROGMEM = {',
+        *rows,
+        '};',
+        '',
+    ])
+
+
+def main() -> None:
+    nodes = flatten(parse(SOURCE))
+    TARGET.write_text(render(nodes), encoding='utf-8')
+    sequences = sum(1 for n in nodes if n.action != 'LEADER_ACT_NONE')
+    print(f'✅ {sequences} sequences → {len(nodes)} trie nodes in {TARGET.relative_to(ROOT)}')
+
+
+if __name__ == '__main__':
+    main()
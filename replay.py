@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+Typing Replay Benchmark
+Replays a keystroke log through the keymap itself - built for the PC against the stubbed QMK in
+keymap/tests, once per timing configuration - and compares misfires, extra/lost characters and output
+latency across the configurations
+"""
+
+import argparse
+import csv
+import difflib
+import hashlib
+import itertools
+import math
+import random
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent
+CONFIG = ROOT / 'keymap' / 'config.h'
+KEYMAP = ROOT / 'keymap.yaml'
+TESTS = ROOT / 'keymap' / 'tests'
+BUILD = ROOT / '.build' / 'replay'
+
+KNOBS = ['TAPPING_TERM', 'QUICK_TAP_TERM', 'COMBO_TERM', 'STREAK_TIMEOUT', 'FLOW_TAP_TERM']
+COLS = 12
+SPACE = 40  # SMART_SPC - LAYOUT_planck_grid position
+
+# HID usage → character, for scoring the output against the text the log was typed as
+CODES = {**{4 + i: chr(ord('a') + i) for i in range(26)}, 0x2C: ' ', 0x34: "'", 0x36: ',', 0x37: '.'}
+SHIFT = 0x22  # Left/right Shift bits in the report's mods byte
+
+
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+# KEYMAP AND CONFIG
+# Read from the same sources the firmware builds from - edit those, not this file
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+
+def config() -> dict:
+    """Timing knobs as config.h sets them."""
+    text = CONFIG.read_text(encoding='utf-8')
+    values = {}
+    for name in KNOBS:
+        match = re.search(rf'^#define {name} (\d+)', text, re.M)
+        if not match:
+            sys.exit(f'❌ {name} not found in {CONFIG.relative_to(ROOT)}')
+        values[name] = int(match.group(1))
+    return values
+
+
+def letters() -> dict:
+    """Character → DEF position, from the keymap-drawer legend."""
+    text = KEYMAP.read_text(encoding='utf-8')
+    block = re.search(r'^  _DEF:\n((?:    - \[.*\]\n)+)', text, re.M).group(1)
+    layout = {}
+    for row, line in enumerate(block.splitlines()):
+        for col, label in enumerate(re.findall(r'"([^"]*)"|([^,\[\]\s]+)', line.split('- ', 1)[1])):
+            label = label[0] or label[1]
+            if label and (label[0].isalpha() or label[0] in ",.'") and not (row == 3):
+                layout.setdefault(label[0].lower(), row * COLS + col)
+    layout[' '] = layout['\n'] = SPACE
+    return layout
+
+
+def hand(pos: int) -> str:
+    if pos >= 3 * COLS:
+        return '*'  # Thumb row
+    return 'L' if pos % COLS < COLS // 2 else 'R'
+
+
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+# LOGS
+# A log is a time-sorted list of (ms, position, down) - captured or synthesized
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+
+def load(path: Path) -> list:
+    """CSV (ms,pos,down) or a `qmk console` capture of EV_KEY_RAW lines (EVENT_LOG_LEVEL 3)."""
+    text = path.read_text(encoding='utf-8', errors='replace')
+    lost = sum(int(n) for n in re.findall(r'Event log: (\d+) records lost', text))
+    if lost:
+        sys.exit(f'❌ {path} is missing {lost} event log records - the ring overflowed during the capture.\n'
+                 f'   Raise EVENT_LOG_SIZE (up to 128) in config.h and capture again')
+    raw = re.findall(r'Raw pos=(\d+) down=(\d) t=(-?\d+)', text)
+    if raw:
+        events, last, offset = [], None, 0
+        for pos, down, stamp in raw:
+            stamp = int(stamp) & 0xFFFF
+            if last is not None and stamp < last - 0x8000:
+                offset += 0x10000  # 16-bit timer wrapped
+            last = stamp
+            events.append((stamp + offset, int(pos), down == '1'))
+        return sorted(events)
+    rows = csv.reader(line for line in text.splitlines() if line and not line.startswith('#'))
+    return sorted((int(t), int(pos), down.strip() in ('1', 'down', 'true')) for t, pos, down in rows)
+
+
+def synthesize(text: str, wpm: float, seed: int) -> list:
+    """Press/release times for a text: lognormal intervals around the WPM, same-hand bigrams slower."""
+    layout, rng = letters(), random.Random(seed)
+    mean = 60000 / (wpm * 5)
+    events, t, previous = [], 0.0, None
+    for char in text.lower():
+        pos = layout.get(char)
+        if pos is None:
+            continue
+        interval = mean * (1.15 if previous is not None and hand(previous) == hand(pos) else 0.85)
+        t += rng.lognormvariate(math.log(interval), 0.35)
+        hold = min(250, max(40, rng.gauss(110 if pos == SPACE else 95, 25)))
+        events += [(round(t), pos, True), (round(t + hold), pos, False)]
+        previous = pos
+    return sorted(events, key=lambda e: (e[0], not e[2]))
+
+
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+# REPLAY
+# keymap/tests/replay_host.c, built with config.h plus a header redefining the knobs under test
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+
+def build(knobs: dict) -> Path:
+    """replay_host for one configuration - one build directory each, rebuilt only when sources change."""
+    overrides = ''.join(f'#undef {name}\n#define {name} {value}\n' for name, value in knobs.items())
+    build_dir = BUILD / hashlib.sha1(overrides.encode()).hexdigest()[:10]
+    build_dir.mkdir(parents=True, exist_ok=True)
+    header = build_dir / 'overrides.h'
+    if not header.exists() or header.read_text() != overrides:
+        header.write_text(overrides)
+
+    for command in (['cmake', '-S', str(TESTS), '-B', str(build_dir), '-DKEYMAP_TESTS=OFF',
+                     f'-DKEYMAP_CONFIG_OVERRIDE={header}'],
+                    ['cmake', '--build', str(build_dir), '--target', 'replay_host', '-j']):
+        result = subprocess.run(command, capture_output=True, text=True)
+        if result.returncode:
+            sys.exit(f'❌ {" ".join(command)}\n{result.stdout}{result.stderr}')
+    return build_dir / 'replay_host'
+
+
+def run(binary: Path, events: list) -> list:
+    """(ms, code, mods) for every key the host saw go down."""
+    log = ''.join(f'{t},{p},{int(d)}\n' for t, p, d in events)
+    result = subprocess.run([str(binary)], input=log, capture_output=True, text=True, check=True)
+    return [tuple(int(v) for v in line.split(',')) for line in result.stdout.splitlines()]
+
+
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+# SCORING
+# Every key in the log is taken as intended text: a hold, layer or combo is a misfire
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+
+def intended(events: list) -> list:
+    """(press ms, character) for each press of a key that types text on DEF."""
+    text = {pos: char for char, pos in letters().items() if char != '\n'}
+    return [(t, text[pos]) for t, pos, down in events if down and pos in text]
+
+
+def typed(output: list) -> list:
+    """(ms, token) per key the host received - a character, or <code> with any non-Shift mods."""
+    tokens = []
+    for t, code, mods in output:
+        token = CODES.get(code, f'<{code}>')
+        if mods & ~SHIFT:
+            token = f'<{mods:02x}:{code}>'
+        tokens.append((t, token))
+    return tokens
+
+
+def score(wanted: list, got: list) -> dict:
+    """Aligns what was typed with what came out - each differing stretch is one misfire."""
+    matcher = difflib.SequenceMatcher(None, [c for _, c in wanted], [c for _, c in got], autojunk=False)
+    stats = {'keys': len(wanted), 'misfires': 0, 'extra': 0, 'lost': 0}
+    latencies = []
+    for op, i1, i2, j1, j2 in matcher.get_opcodes():
+        if op == 'equal':
+            latencies += [got[j1 + k][0] - wanted[i1 + k][0] for k in range(i2 - i1)]
+        else:
+            stats['misfires'] += 1
+            stats['lost'] += i2 - i1
+            stats['extra'] += j2 - j1
+
+    latencies.sort()
+    for p in (50, 90, 99):
+        stats[f'p{p}'] = latencies[min(len(latencies) - 1, len(latencies) * p // 100)] if latencies else 0
+    stats['max'] = latencies[-1] if latencies else 0
+    return stats
+
+
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+# MAIN
+# ═══════════════════════════════════════════════════════════════════════════════════════════════════
+
+def variations(base: dict, vary: list) -> list:
+    axes = []
+    for spec in vary:
+        name, _, values = spec.partition('=')
+        if name not in KNOBS or not values:
+            sys.exit(f'❌ --vary expects NAME=v1,v2 with NAME one of {", ".join(KNOBS)}')
+        axes.append([(name, int(v)) for v in values.split(',')])
+    return [dict(base, **dict(combo)) for combo in itertools.product(*axes)] if axes else [base]
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--log', type=Path, help='keystroke log: CSV ms,pos,down or a qmk console capture')
+    source.add_argument('--corpus', type=Path, help='text to synthesize a log from')
+    parser.add_argument('--wpm', type=float, default=70, help='synthesized typing speed (default 70)')
+    parser.add_argument('--seed', type=int, default=1, help='synthesized timing seed (default 1)')
+    parser.add_argument('--export', type=Path, help='write the log as CSV (ms,pos,down) and continue')
+    parser.add_argument('--vary', action='append', default=[], metavar='NAME=v1,v2',
+                        help=f'knob values to compare ({", ".join(KNOBS)}); repeat for a grid')
+    args = parser.parse_args()
+
+    if args.log:
+        events = load(args.log)
+    else:
+        events = synthesize(args.corpus.read_text(encoding='utf-8'), args.wpm, args.seed)
+    if args.export:
+        args.export.write_text('# ms,pos,down\n' + ''.join(f'{t},{p},{int(d)}\n' for t, p, d in events),
+                               encoding='utf-8')
+    wanted = intended(events)
+    if not wanted:
+        sys.exit('❌ No text key presses in the log')
+
+    base = config()
+    print(f'⌨️  {len(wanted)} keystrokes through keymap/ built for the host\n')
+    header = ' '.join(f'{k.replace("_TERM", "").replace("_TIMEOUT", ""):>6}' for k in KNOBS)
+    print(f'{header}  misfire%  extra   lost    p50    p90    p99    max ms')
+    for knobs in variations(base, args.vary):
+        s = score(wanted, typed(run(build(knobs), events)))
+        marker = '  (config.h)' if knobs == base else ''
+        print(' '.join(f'{knobs[k]:6}' for k in KNOBS) +
+              f'  {100 * s["misfires"] / s["keys"]:7.2f}% {s["extra"]:6} {s["lost"]:6}'
+              f' {s["p50"]:6} {s["p90"]:6} {s["p99"]:6} {s["max"]:6}{marker}')
+
+
+if __name__ == '__main__':
+    main()